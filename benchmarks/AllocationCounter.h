@@ -0,0 +1,132 @@
+#ifndef AISDI_LINEAR_ALLOCATIONCOUNTER_H
+#define AISDI_LINEAR_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// Heap traffic of the calling thread while counting was on. Live bytes are
+// the usable sizes malloc reports, so they include its rounding; they go
+// negative when memory allocated earlier is freed.
+struct AllocationCounts
+{
+  std::size_t allocations;
+  std::size_t frees;
+  std::size_t bytes;
+  long long liveBytes;
+  long long peakLiveBytes;
+};
+
+namespace detail
+{
+
+struct AllocationCounterState
+{
+  AllocationCounts counts;
+  bool counting;
+};
+
+// Constant-initialised, so the hooks may use it at any time, even while the
+// thread is being set up or torn down.
+inline AllocationCounterState& allocationCounterState()
+{
+  static thread_local AllocationCounterState state = { { 0, 0, 0, 0, 0 }, false };
+  return state;
+}
+
+inline bool& allocationHooksInstalled()
+{
+  static bool installed = false;
+  return installed;
+}
+
+inline long long usableSize(void* pointer)
+{
+#if defined(__GLIBC__)
+  return (long long)malloc_usable_size(pointer);
+#else
+  (void)pointer;
+  return 0;
+#endif
+}
+
+// Called by the operator new and delete of AllocationHooks.cpp.
+inline void onAllocated(void* pointer, std::size_t size)
+{
+  AllocationCounterState& state = allocationCounterState();
+  if(!state.counting)
+    return;
+  state.counts.allocations++;
+  state.counts.bytes += size;
+  state.counts.liveBytes += usableSize(pointer);
+  if(state.counts.liveBytes > state.counts.peakLiveBytes)
+    state.counts.peakLiveBytes = state.counts.liveBytes;
+}
+
+inline void onFreed(void* pointer)
+{
+  AllocationCounterState& state = allocationCounterState();
+  if(!state.counting)
+    return;
+  state.counts.frees++;
+  state.counts.liveBytes -= usableSize(pointer);
+}
+
+}
+
+// Whether AllocationHooks.cpp is linked in; without it nothing is counted.
+inline bool allocationHooksInstalled()
+{
+  return detail::allocationHooksInstalled();
+}
+
+// Counts the calling thread's allocations from construction to stop(). Not
+// reentrant: one counter per thread at a time.
+class AllocationCounter
+{
+  bool stopped;
+  AllocationCounts result;
+
+public:
+  AllocationCounter()
+    : stopped(false), result()
+  {
+    detail::AllocationCounterState& state = detail::allocationCounterState();
+    state.counts = AllocationCounts();
+    state.counting = true;
+  }
+
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+  ~AllocationCounter()
+  {
+    stop();
+  }
+
+  const AllocationCounts& stop()
+  {
+    if(!stopped)
+    {
+      detail::AllocationCounterState& state = detail::allocationCounterState();
+      state.counting = false;
+      result = state.counts;
+      stopped = true;
+    }
+    return result;
+  }
+};
+
+}
+
+}
+
+#endif // AISDI_LINEAR_ALLOCATIONCOUNTER_H
@@ -0,0 +1,117 @@
+// Replaces the global operator new and delete with malloc and free plus the
+// counting of AllocationCounter.h. Link it into a program to count its
+// allocations; counting costs a thread-local check while it is off.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+namespace
+{
+
+void* allocate(std::size_t size)
+{
+  if(size == 0)
+    size = 1;
+  for(;;)
+  {
+    void* pointer = std::malloc(size);
+    if(pointer != nullptr)
+    {
+      aisdi::bench::detail::onAllocated(pointer, size);
+      return pointer;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if(handler == nullptr)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void* allocateOrNull(std::size_t size) noexcept
+{
+  try
+  {
+    return allocate(size);
+  }
+  catch(const std::bad_alloc&)
+  {
+    return nullptr;
+  }
+}
+
+void release(void* pointer) noexcept
+{
+  if(pointer == nullptr)
+    return;
+  aisdi::bench::detail::onFreed(pointer);
+  std::free(pointer);
+}
+
+struct Installer
+{
+  Installer()
+  {
+    aisdi::bench::detail::allocationHooksInstalled() = true;
+  }
+};
+
+const Installer installer;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocateOrNull(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return allocateOrNull(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  release(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+  release(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+  release(pointer);
+}
+
+// Sized deletes are called by code built for C++14 or later, such as the
+// Boost libraries, whatever standard this file is compiled for. The
+// runtime's own would free our blocks uncounted, and a sanitizer's reports
+// them as freed by the wrong allocator.
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  release(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  release(pointer);
+}
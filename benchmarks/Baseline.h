@@ -0,0 +1,192 @@
+#ifndef AISDI_LINEAR_BASELINE_H
+#define AISDI_LINEAR_BASELINE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Benchmark.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// One-sided Mann-Whitney U test: the probability of seeing candidate rank
+// this high above baseline if both came from the same distribution. Uses
+// the normal approximation with tie and continuity corrections, which is
+// close enough from about 8 samples a side. 1 when there's nothing to rank.
+inline double mannWhitneyGreaterPValue(const Vector<double>& baseline, const Vector<double>& candidate)
+{
+  const double n1 = (double)baseline.getSize();
+  const double n2 = (double)candidate.getSize();
+  if(baseline.isEmpty() or candidate.isEmpty())
+    return 1.0;
+
+  // value, and whether it is the candidate's
+  Vector<std::pair<double, bool>> pooled;
+  for(double sample : baseline)
+    pooled.append(std::make_pair(sample, false));
+  for(double sample : candidate)
+    pooled.append(std::make_pair(sample, true));
+  std::pair<double, bool>* first = pooled.data();
+  const size_type count = pooled.getSize();
+  std::sort(first, first + count);
+
+  double candidateRanks = 0;
+  double tieCorrection = 0;
+  for(size_type start = 0; start != count; )
+  {
+    size_type end = start + 1;
+    while(end != count and first[end].first == first[start].first)
+      end++;
+    // ranks start..end-1, counted from 1, share their mean
+    const double rank = (start + 1 + end) / 2.0;
+    for(size_type i = start; i != end; i++)
+      if(first[i].second)
+        candidateRanks += rank;
+    const double ties = (double)(end - start);
+    tieCorrection += ties * ties * ties - ties;
+    start = end;
+  }
+
+  const double n = n1 + n2;
+  const double u = candidateRanks - n2 * (n2 + 1) / 2;
+  const double mean = n1 * n2 / 2;
+  const double variance = n1 * n2 / 12 * ((n + 1) - tieCorrection / (n * (n - 1)));
+  if(variance <= 0)
+    return 1.0;
+  const double z = (u - mean - 0.5) / std::sqrt(variance);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Benchmark name to its ns/op samples.
+using Baseline = std::map<std::string, Vector<double>>;
+
+const char* const baselineHeader = "# aisdi benchmark baseline 1";
+
+// One line per result: its name, then every sample. Throws
+// std::runtime_error when the file can't be written.
+inline void saveBaseline(const std::string& path, const Vector<Result>& results)
+{
+  std::ofstream out(path.c_str(), std::ios::trunc);
+  if(!out)
+    throw std::runtime_error("Can't write baseline " + path);
+  out<<baselineHeader<<'\n'<<std::setprecision(17);
+  for(const Result& result : results)
+  {
+    out<<result.operation<<'/'<<result.container<<'/'<<result.element<<'/'<<result.size;
+    for(double sample : result.samples)
+      out<<' '<<sample;
+    out<<'\n';
+  }
+  if(!out.flush())
+    throw std::runtime_error("Can't write baseline " + path);
+}
+
+// Throws std::runtime_error when the file can't be read or isn't a baseline.
+inline Baseline loadBaseline(const std::string& path)
+{
+  std::ifstream in(path.c_str());
+  if(!in)
+    throw std::runtime_error("Can't read baseline " + path);
+  std::string line;
+  if(!std::getline(in, line) or line != baselineHeader)
+    throw std::runtime_error(path + " is not a benchmark baseline");
+  Baseline baseline;
+  while(std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    std::string name;
+    if(!(fields>>name))
+      continue;
+    Vector<double>& samples = baseline[name];
+    double sample;
+    while(fields>>sample)
+      samples.append(sample);
+    if(!fields.eof() or samples.isEmpty())
+      throw std::runtime_error(path + " has a malformed line for " + name);
+  }
+  return baseline;
+}
+
+struct Comparison
+{
+  std::string name;
+  double baselineMedian;
+  double candidateMedian;
+  // candidate median over baseline median, minus one
+  double change;
+  double slowerPValue;
+  double fasterPValue;
+  bool regression;
+  bool improvement;
+};
+
+// A slowdown counts as a regression when it is both significant (p below
+// alpha) and bigger than threshold, a fraction of the baseline median;
+// the threshold keeps run-to-run noise from failing the gate. Results
+// without a baseline are skipped.
+inline Vector<Comparison> compareWithBaseline(const Baseline& baseline, const Vector<Result>& results,
+                                              double alpha, double threshold)
+{
+  Vector<Comparison> comparisons;
+  for(const Result& result : results)
+  {
+    const std::string name = result.operation + "/" + result.container + "/" + result.element + "/" +
+                             std::to_string(result.size);
+    const auto found = baseline.find(name);
+    if(found == baseline.end())
+      continue;
+    Comparison comparison;
+    comparison.name = name;
+    comparison.baselineMedian = summarize(found->second).median;
+    comparison.candidateMedian = result.nanosecondsPerOperation.median;
+    comparison.change = comparison.baselineMedian > 0 ?
+                        comparison.candidateMedian / comparison.baselineMedian - 1 : 0;
+    comparison.slowerPValue = mannWhitneyGreaterPValue(found->second, result.samples);
+    comparison.fasterPValue = mannWhitneyGreaterPValue(result.samples, found->second);
+    comparison.regression = comparison.slowerPValue < alpha and comparison.change > threshold;
+    comparison.improvement = comparison.fasterPValue < alpha and comparison.change < -threshold;
+    comparisons.append(comparison);
+  }
+  return comparisons;
+}
+
+inline bool hasRegression(const Vector<Comparison>& comparisons)
+{
+  for(const Comparison& comparison : comparisons)
+    if(comparison.regression)
+      return true;
+  return false;
+}
+
+inline void writeComparison(std::ostream& out, const Vector<Comparison>& comparisons)
+{
+  out<<std::left<<std::setw(36)<<"benchmark"<<std::right<<std::setw(16)<<"baseline [ns]"
+     <<std::setw(14)<<"now [ns]"<<std::setw(10)<<"change"<<std::setw(12)<<"p"<<"  verdict"<<std::endl;
+  for(const Comparison& comparison : comparisons)
+  {
+    const double p = comparison.change >= 0 ? comparison.slowerPValue : comparison.fasterPValue;
+    out<<std::left<<std::setw(36)<<comparison.name<<std::right<<std::fixed<<std::setprecision(2)
+       <<std::setw(16)<<comparison.baselineMedian<<std::setw(14)<<comparison.candidateMedian
+       <<std::setw(9)<<comparison.change * 100<<"%"<<std::setw(12)<<std::setprecision(4)<<p<<"  "
+       <<(comparison.regression ? "SLOWER" : comparison.improvement ? "faster" : "same")<<std::endl;
+  }
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_BASELINE_H
@@ -0,0 +1,732 @@
+#ifndef AISDI_LINEAR_BENCHMARK_H
+#define AISDI_LINEAR_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "Vector.h"
+
+#include "AllocationCounter.h"
+#include "LatencyHistogram.h"
+#include "PerfCounters.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+using size_type = std::size_t;
+using Clock = std::chrono::steady_clock;
+
+// Makes the compiler assume value is read, so the work producing it stays.
+template <typename Type>
+inline void doNotOptimize(const Type& value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Handed to a benchmark body, which prepares its container untimed and
+// wraps only the measured work in time(). With counters, their events are
+// counted around the same work; so are the heap allocations, when asked to.
+// Bodies that run one operation at a time use timeEach(), which also records
+// every operation's latency when given a histogram.
+class Measurement
+{
+  Clock::duration elapsed;
+  size_type operations;
+  PerfCounters* counters;
+  CounterValues counts;
+  bool countingAllocations;
+  AllocationCounts allocations;
+  LatencyHistogram* latencies;
+
+  template <typename Timed>
+  void timeRegion(Timed& timed)
+  {
+    if(counters != nullptr)
+      counters->start();
+    const Clock::time_point start = Clock::now();
+    timed();
+    elapsed += Clock::now() - start;
+    if(counters != nullptr)
+      counters->stop(counts);
+  }
+
+public:
+  explicit Measurement(PerfCounters* counters_ = nullptr, bool countAllocations = false,
+                       LatencyHistogram* latencies_ = nullptr)
+    : elapsed(Clock::duration::zero()), operations(0), counters(counters_),
+      countingAllocations(countAllocations), allocations(), latencies(latencies_)
+  {}
+
+  // Runs timed() and counts it as operationCount operations.
+  template <typename Timed>
+  void time(size_type operationCount, Timed timed)
+  {
+    if(countingAllocations)
+    {
+      AllocationCounter counter;
+      timeRegion(timed);
+      const AllocationCounts& region = counter.stop();
+      allocations.allocations += region.allocations;
+      allocations.frees += region.frees;
+      allocations.bytes += region.bytes;
+      allocations.liveBytes += region.liveBytes;
+      allocations.peakLiveBytes = std::max(allocations.peakLiveBytes, region.peakLiveBytes);
+    }
+    else
+      timeRegion(timed);
+    operations += operationCount;
+  }
+
+  // Times operation(index) for every index below operationCount. Reading the
+  // clock around each one adds some nanoseconds to the total time.
+  template <typename Operation>
+  void timeEach(size_type operationCount, Operation operation)
+  {
+    if(latencies == nullptr)
+    {
+      time(operationCount, [&]()
+      {
+        for(size_type index = 0; index != operationCount; index++)
+          operation(index);
+      });
+      return;
+    }
+    time(operationCount, [&]()
+    {
+      for(size_type index = 0; index != operationCount; index++)
+      {
+        const std::uint64_t start = readTicks();
+        operation(index);
+        latencies->record(readTicks() - start);
+      }
+    });
+  }
+
+  const CounterValues& getCounts() const
+  {
+    return counts;
+  }
+
+  // Summed over the timed regions, except peakLiveBytes: the highest any
+  // region rose above where it started.
+  const AllocationCounts& getAllocations() const
+  {
+    return allocations;
+  }
+
+  double getNanoseconds() const
+  {
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+  }
+
+  size_type getOperations() const
+  {
+    return operations;
+  }
+
+  double nanosecondsPerOperation() const
+  {
+    return operations != 0 ? getNanoseconds() / operations : 0.0;
+  }
+};
+
+struct Summary
+{
+  double median;
+  double min;
+  double mean;
+  double stddev;
+  size_type samples;
+};
+
+// Sample standard deviation; 0 for fewer than two samples.
+inline Summary summarize(Vector<double> samples)
+{
+  Summary summary = Summary();
+  summary.samples = samples.getSize();
+  if(samples.isEmpty())
+    return summary;
+  double* first = samples.data();
+  double* last = first + samples.getSize();
+  std::sort(first, last);
+  const size_type middle = samples.getSize() / 2;
+  summary.median = samples.getSize() % 2 != 0 ? first[middle] : (first[middle - 1] + first[middle]) / 2;
+  summary.min = *first;
+  double sum = 0;
+  for(double* sample = first; sample != last; sample++)
+    sum += *sample;
+  summary.mean = sum / samples.getSize();
+  if(samples.getSize() > 1)
+  {
+    double squares = 0;
+    for(double* sample = first; sample != last; sample++)
+      squares += (*sample - summary.mean) * (*sample - summary.mean);
+    summary.stddev = std::sqrt(squares / (samples.getSize() - 1));
+  }
+  return summary;
+}
+
+// One operation on one container of one element type; the size comes from
+// the command line. body(measurement, size) must start from a fresh container
+// every call, so that every run sees the same state.
+struct Case
+{
+  std::string operation;
+  std::string container;
+  std::string element;
+  std::function<void(Measurement&, size_type)> body;
+};
+
+inline std::string caseName(const Case& benchmark, size_type size)
+{
+  return benchmark.operation + "/" + benchmark.container + "/" + benchmark.element + "/" +
+         std::to_string(size);
+}
+
+class Registry
+{
+  Vector<Case> cases;
+
+public:
+  void add(const std::string& operation, const std::string& container, const std::string& element,
+           std::function<void(Measurement&, size_type)> body)
+  {
+    Case benchmark;
+    benchmark.operation = operation;
+    benchmark.container = container;
+    benchmark.element = element;
+    benchmark.body = std::move(body);
+    cases.append(benchmark);
+  }
+
+  const Vector<Case>& getCases() const
+  {
+    return cases;
+  }
+};
+
+struct Options
+{
+  // operation/container/element/size patterns where * matches anything
+  Vector<std::string> filters;
+  Vector<size_type> sizes;
+  size_type warmup;
+  size_type repetitions;
+  // each sample repeats the body until it ran at least this long
+  size_type minSampleMicroseconds;
+  std::string format;
+  std::string output;
+  bool list;
+  bool counters;
+  bool allocations;
+  bool latencies;
+  // where to write the latency histograms, if anywhere
+  std::string histogramOutput;
+  // baseline files to write, and to compare with (see Baseline.h)
+  std::string baselineOutput;
+  std::string baselineInput;
+  // a regression is significant at alpha and slower by more than threshold
+  double alpha;
+  double threshold;
+
+  Options()
+    : sizes({ 1000, 10000, 100000 }), warmup(0), repetitions(10), minSampleMicroseconds(1000),
+      format("table"), list(false), counters(true), allocations(false), latencies(false),
+      alpha(0.01), threshold(0.05)
+  {}
+};
+
+const char* const usage =
+  "options:\n"
+  "  --filter=PATTERN   operation/container/element/size, * matches anything;\n"
+  "                     repeat for alternatives (default: all)\n"
+  "  --sizes=N,N...     container sizes (default: 1000,10000,100000)\n"
+  "  --warmup=N         unrecorded runs after the calibration run (default: 0)\n"
+  "  --repetitions=N    recorded samples per benchmark (default: 10)\n"
+  "  --min-time=US      shortest sample, in microseconds (default: 1000)\n"
+  "  --format=FORMAT    table, csv or json (default: table)\n"
+  "  --output=FILE      write the results there instead of stdout\n"
+  "  --no-counters      don't read hardware performance counters\n"
+  "  --allocations      count heap allocations of the measured operations\n"
+  "  --latencies        record the latency of every single operation\n"
+  "  --histogram=FILE   write the latency histograms there as CSV; implies --latencies\n"
+  "  --save-baseline=FILE  keep every sample there for later comparisons\n"
+  "  --compare=FILE     compare with a saved baseline; exit 1 on a regression\n"
+  "  --alpha=P          significance level of the comparison (default: 0.01)\n"
+  "  --threshold=PCT    smallest slowdown that fails it, in % (default: 5)\n"
+  "  --list             print the selected benchmarks and exit\n";
+
+inline bool matchesPattern(const char* pattern, const char* name)
+{
+  if(*pattern == '\0')
+    return *name == '\0';
+  if(*pattern == '*')
+    return matchesPattern(pattern + 1, name) or (*name != '\0' and matchesPattern(pattern, name + 1));
+  return *pattern == *name and matchesPattern(pattern + 1, name + 1);
+}
+
+// Whether any of filters matches name; everything is selected without any.
+inline bool isSelected(const Vector<std::string>& filters, const std::string& name)
+{
+  if(filters.isEmpty())
+    return true;
+  for(const std::string& filter : filters)
+    if(matchesPattern(filter.c_str(), name.c_str()))
+      return true;
+  return false;
+}
+
+inline bool isSelected(const Options& options, const std::string& name)
+{
+  return isSelected(options.filters, name);
+}
+
+namespace detail
+{
+
+inline size_type parseCount(const std::string& option, const std::string& text)
+{
+  char* end = nullptr;
+  const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+  if(text.empty() or *end != '\0' or text[0] == '-')
+    throw std::invalid_argument("Bad number in " + option);
+  return value;
+}
+
+inline double parseFraction(const std::string& option, const std::string& text)
+{
+  char* end = nullptr;
+  const double value = std::strtod(text.c_str(), &end);
+  if(text.empty() or *end != '\0' or !(value >= 0))
+    throw std::invalid_argument("Bad number in " + option);
+  return value;
+}
+
+// Comma-separated counts, none of them 0: an empty container has nothing to
+// erase or pop, and zero threads run nothing.
+inline Vector<size_type> parseCountList(const std::string& option, const std::string& text)
+{
+  Vector<size_type> counts;
+  std::istringstream list(text);
+  std::string count;
+  while(std::getline(list, count, ','))
+  {
+    const size_type parsed = parseCount(option, count);
+    if(parsed == 0)
+      throw std::invalid_argument("Counts must be positive in " + option);
+    counts.append(parsed);
+  }
+  if(counts.isEmpty())
+    throw std::invalid_argument("No numbers in " + option);
+  return counts;
+}
+
+inline bool isFormat(const std::string& value)
+{
+  return value == "table" or value == "csv" or value == "json";
+}
+
+}
+
+// A command line argument split at its first '='; value is empty for a
+// flag.
+struct CommandLineOption
+{
+  std::string name;
+  std::string value;
+
+  explicit CommandLineOption(const std::string& argument)
+  {
+    const size_type equals = argument.find('=');
+    name = argument.substr(0, equals);
+    value = equals != std::string::npos ? argument.substr(equals + 1) : "";
+  }
+};
+
+// Throws std::invalid_argument for unknown options and malformed values.
+inline Options parseOptions(int argc, const char* const* argv)
+{
+  Options options;
+  for(int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    const CommandLineOption option(argument);
+    const std::string& name = option.name;
+    const std::string& value = option.value;
+    if(name == "--filter")
+      options.filters.append(value);
+    else if(name == "--sizes")
+      options.sizes = detail::parseCountList(argument, value);
+    else if(name == "--warmup")
+      options.warmup = detail::parseCount(argument, value);
+    else if(name == "--repetitions")
+      options.repetitions = std::max<size_type>(1, detail::parseCount(argument, value));
+    else if(name == "--min-time")
+      options.minSampleMicroseconds = detail::parseCount(argument, value);
+    else if(name == "--format" and detail::isFormat(value))
+      options.format = value;
+    else if(name == "--output" and !value.empty())
+      options.output = value;
+    else if(argument == "--list")
+      options.list = true;
+    else if(argument == "--no-counters")
+      options.counters = false;
+    else if(argument == "--allocations")
+      options.allocations = true;
+    else if(argument == "--latencies")
+      options.latencies = true;
+    else if(name == "--histogram" and !value.empty())
+    {
+      options.latencies = true;
+      options.histogramOutput = value;
+    }
+    else if(name == "--save-baseline" and !value.empty())
+      options.baselineOutput = value;
+    else if(name == "--compare" and !value.empty())
+      options.baselineInput = value;
+    else if(name == "--alpha")
+      options.alpha = detail::parseFraction(argument, value);
+    else if(name == "--threshold")
+      options.threshold = detail::parseFraction(argument, value) / 100;
+    else
+      throw std::invalid_argument("Unknown option " + argument);
+  }
+  return options;
+}
+
+struct Result
+{
+  std::string operation;
+  std::string container;
+  std::string element;
+  size_type size;
+  // body calls per sample
+  size_type batch;
+  Summary nanosecondsPerOperation;
+  // every sample, in the order taken
+  Vector<double> samples;
+  // over all samples; only the counted ones mean anything
+  CounterValues countsPerOperation;
+  bool counted[counterCount];
+  // with --allocations and the hooks linked in
+  bool allocationsCounted;
+  double allocationsPerOperation;
+  double freesPerOperation;
+  double bytesPerOperation;
+  long long peakLiveBytes;
+  // in ticks, from every sample; null without --latencies, empty for a case
+  // that doesn't time single operations
+  std::shared_ptr<const LatencyHistogram> latencies;
+
+  // Nothing measured: no counters, no allocations, no latencies.
+  Result()
+    : size(0), batch(0), nanosecondsPerOperation(), allocationsCounted(false), allocationsPerOperation(0),
+      freesPerOperation(0), bytesPerOperation(0), peakLiveBytes(0)
+  {
+    for(bool& isCounted : counted)
+      isCounted = false;
+  }
+};
+
+// A latency from a Result's histogram in nanoseconds.
+inline double latencyNanoseconds(std::uint64_t ticks)
+{
+  return ticks / ticksPerNanosecond();
+}
+
+inline bool hasLatencies(const Result& result)
+{
+  return result.latencies != nullptr and result.latencies->getCount() != 0;
+}
+
+const double reportedPercentiles[] = { 50, 90, 99, 99.9 };
+const char* const reportedPercentileNames[] = { "p50", "p90", "p99", "p99.9" };
+
+// Samples one case at one size. An unrecorded calibration run always comes
+// first and picks how many body calls make a sample of at least
+// options.minSampleMicroseconds; options.warmup more runs follow it.
+// Without counters, or for the ones that aren't available, nothing is counted.
+inline Result runCase(const Case& benchmark, size_type size, const Options& options,
+                      PerfCounters* counters = nullptr)
+{
+  Result result;
+  result.operation = benchmark.operation;
+  result.container = benchmark.container;
+  result.element = benchmark.element;
+  result.size = size;
+
+  Measurement calibration;
+  benchmark.body(calibration, size);
+  const double minNanoseconds = options.minSampleMicroseconds * 1000.0;
+  const double once = std::max(calibration.getNanoseconds(), 1.0);
+  result.batch = std::max<size_type>(1, (size_type)std::ceil(minNanoseconds / once));
+  for(size_type run = 0; run != options.warmup; run++)
+  {
+    Measurement warmup;
+    benchmark.body(warmup, size);
+  }
+
+  Vector<double> samples;
+  CounterValues counts;
+  size_type operations = 0;
+  result.allocationsCounted = options.allocations and allocationHooksInstalled();
+  AllocationCounts allocations = AllocationCounts();
+  std::shared_ptr<LatencyHistogram> latencies;
+  if(options.latencies)
+    latencies = std::make_shared<LatencyHistogram>();
+  for(size_type repetition = 0; repetition != options.repetitions; repetition++)
+  {
+    Measurement measurement(counters, result.allocationsCounted, latencies.get());
+    for(size_type call = 0; call != result.batch; call++)
+      benchmark.body(measurement, size);
+    samples.append(measurement.nanosecondsPerOperation());
+    counts += measurement.getCounts();
+    operations += measurement.getOperations();
+    allocations.allocations += measurement.getAllocations().allocations;
+    allocations.frees += measurement.getAllocations().frees;
+    allocations.bytes += measurement.getAllocations().bytes;
+    allocations.peakLiveBytes = std::max(allocations.peakLiveBytes,
+                                         measurement.getAllocations().peakLiveBytes);
+  }
+  const double perOperation = operations != 0 ? 1.0 / operations : 0.0;
+  result.allocationsPerOperation = allocations.allocations * perOperation;
+  result.freesPerOperation = allocations.frees * perOperation;
+  result.bytesPerOperation = allocations.bytes * perOperation;
+  result.peakLiveBytes = allocations.peakLiveBytes;
+  result.latencies = latencies;
+  result.nanosecondsPerOperation = summarize(samples);
+  result.samples = samples;
+  for(size_type counter = 0; counter != counterCount; counter++)
+  {
+    result.counted[counter] = counters != nullptr and counters->isAvailable(counter) and operations != 0;
+    result.countsPerOperation.values[counter] = result.counted[counter] ? counts.values[counter] / operations : 0;
+  }
+  return result;
+}
+
+inline Vector<Result> runSelected(const Registry& registry, const Options& options,
+                                  PerfCounters* counters = nullptr)
+{
+  Vector<Result> results;
+  for(const Case& benchmark : registry.getCases())
+    for(size_type size : options.sizes)
+      if(isSelected(options, caseName(benchmark, size)))
+        results.append(runCase(benchmark, size, options, counters));
+  return results;
+}
+
+// Counter columns appear only for counters some result has.
+inline void writeTable(std::ostream& out, const Vector<Result>& results)
+{
+  bool shown[counterCount] = {};
+  for(const Result& result : results)
+    for(size_type counter = 0; counter != counterCount; counter++)
+      shown[counter] = shown[counter] or result.counted[counter];
+
+  out<<std::left<<std::setw(14)<<"operation"<<std::setw(12)<<"container"<<std::setw(10)<<"element"
+     <<std::right<<std::setw(10)<<"size"<<std::setw(14)<<"median [ns]"<<std::setw(14)<<"min [ns]"
+     <<std::setw(14)<<"stddev [ns]";
+  for(size_type counter = 0; counter != counterCount; counter++)
+    if(shown[counter])
+      out<<std::setw(15)<<counterName(counter);
+  bool allocationsShown = false;
+  for(const Result& result : results)
+    allocationsShown = allocationsShown or result.allocationsCounted;
+  if(allocationsShown)
+    out<<std::setw(12)<<"allocs"<<std::setw(12)<<"frees"<<std::setw(12)<<"bytes"<<std::setw(14)<<"peak live [B]";
+  bool latenciesShown = false;
+  for(const Result& result : results)
+    latenciesShown = latenciesShown or hasLatencies(result);
+  if(latenciesShown)
+  {
+    for(const char* name : reportedPercentileNames)
+      out<<std::setw(12)<<(std::string(name) + " [ns]");
+    out<<std::setw(12)<<"max [ns]";
+  }
+  out<<std::endl;
+  for(const Result& result : results)
+  {
+    const Summary& summary = result.nanosecondsPerOperation;
+    out<<std::left<<std::setw(14)<<result.operation<<std::setw(12)<<result.container
+       <<std::setw(10)<<result.element<<std::right<<std::setw(10)<<result.size
+       <<std::fixed<<std::setprecision(2)<<std::setw(14)<<summary.median<<std::setw(14)<<summary.min
+       <<std::setw(14)<<summary.stddev;
+    for(size_type counter = 0; counter != counterCount; counter++)
+    {
+      if(!shown[counter])
+        continue;
+      out<<std::setw(15);
+      if(result.counted[counter])
+        out<<result.countsPerOperation.values[counter];
+      else
+        out<<"-";
+    }
+    if(allocationsShown and result.allocationsCounted)
+      out<<std::setw(12)<<result.allocationsPerOperation<<std::setw(12)<<result.freesPerOperation
+         <<std::setw(12)<<result.bytesPerOperation<<std::setw(14)<<result.peakLiveBytes;
+    else if(allocationsShown)
+      out<<std::setw(12)<<"-"<<std::setw(12)<<"-"<<std::setw(12)<<"-"<<std::setw(14)<<"-";
+    if(latenciesShown)
+    {
+      for(double percentile : reportedPercentiles)
+        if(hasLatencies(result))
+          out<<std::setw(12)<<latencyNanoseconds(result.latencies->valueAtPercentile(percentile));
+        else
+          out<<std::setw(12)<<"-";
+      if(hasLatencies(result))
+        out<<std::setw(12)<<latencyNanoseconds(result.latencies->getMax());
+      else
+        out<<std::setw(12)<<"-";
+    }
+    out<<std::endl;
+  }
+  if(allocationsShown or shown[cyclesCounter] or shown[instructionsCounter])
+    out<<"(counters, allocations, frees and bytes are per operation)"<<std::endl;
+}
+
+inline void writeCsv(std::ostream& out, const Vector<Result>& results)
+{
+  out<<"operation,container,element,size,samples,batch,median_ns,min_ns,mean_ns,stddev_ns";
+  for(size_type counter = 0; counter != counterCount; counter++)
+    out<<','<<counterName(counter)<<"_per_op";
+  out<<",allocations_per_op,frees_per_op,bytes_per_op,peak_live_bytes,p50_ns,p90_ns,p99_ns,p999_ns,max_ns"<<std::endl;
+  for(const Result& result : results)
+  {
+    const Summary& summary = result.nanosecondsPerOperation;
+    out<<result.operation<<','<<result.container<<','<<result.element<<','<<result.size<<','
+       <<summary.samples<<','<<result.batch<<','<<summary.median<<','<<summary.min<<','
+       <<summary.mean<<','<<summary.stddev;
+    // an empty cell for a counter that wasn't read
+    for(size_type counter = 0; counter != counterCount; counter++)
+    {
+      out<<',';
+      if(result.counted[counter])
+        out<<result.countsPerOperation.values[counter];
+    }
+    if(result.allocationsCounted)
+      out<<','<<result.allocationsPerOperation<<','<<result.freesPerOperation<<','
+         <<result.bytesPerOperation<<','<<result.peakLiveBytes;
+    else
+      out<<",,,,";
+    for(double percentile : reportedPercentiles)
+    {
+      out<<',';
+      if(hasLatencies(result))
+        out<<latencyNanoseconds(result.latencies->valueAtPercentile(percentile));
+    }
+    out<<',';
+    if(hasLatencies(result))
+      out<<latencyNanoseconds(result.latencies->getMax());
+    out<<std::endl;
+  }
+}
+
+inline std::string jsonString(const std::string& text)
+{
+  std::string quoted = "\"";
+  for(auto c = text.begin(); c != text.end(); c++)
+  {
+    if(*c == '"' or *c == '\\')
+      quoted += '\\';
+    quoted += *c;
+  }
+  return quoted + "\"";
+}
+
+inline void writeJson(std::ostream& out, const Vector<Result>& results)
+{
+  out<<"["<<std::endl;
+  size_type written = 0;
+  for(const Result& result : results)
+  {
+    const Summary& summary = result.nanosecondsPerOperation;
+    out<<"  {\"operation\": "<<jsonString(result.operation)
+       <<", \"container\": "<<jsonString(result.container)
+       <<", \"element\": "<<jsonString(result.element)
+       <<", \"size\": "<<result.size<<", \"samples\": "<<summary.samples
+       <<", \"batch\": "<<result.batch<<", \"median_ns\": "<<summary.median
+       <<", \"min_ns\": "<<summary.min<<", \"mean_ns\": "<<summary.mean
+       <<", \"stddev_ns\": "<<summary.stddev;
+    for(size_type counter = 0; counter != counterCount; counter++)
+    {
+      out<<", \""<<counterName(counter)<<"_per_op\": ";
+      if(result.counted[counter])
+        out<<result.countsPerOperation.values[counter];
+      else
+        out<<"null";
+    }
+    if(result.allocationsCounted)
+      out<<", \"allocations_per_op\": "<<result.allocationsPerOperation
+         <<", \"frees_per_op\": "<<result.freesPerOperation
+         <<", \"bytes_per_op\": "<<result.bytesPerOperation
+         <<", \"peak_live_bytes\": "<<result.peakLiveBytes;
+    else
+      out<<", \"allocations_per_op\": null, \"frees_per_op\": null, \"bytes_per_op\": null"
+           ", \"peak_live_bytes\": null";
+    const char* const percentileFields[] = { "p50_ns", "p90_ns", "p99_ns", "p999_ns" };
+    for(size_type percentile = 0; percentile != 4; percentile++)
+    {
+      out<<", \""<<percentileFields[percentile]<<"\": ";
+      if(hasLatencies(result))
+        out<<latencyNanoseconds(result.latencies->valueAtPercentile(reportedPercentiles[percentile]));
+      else
+        out<<"null";
+    }
+    out<<", \"max_ns\": ";
+    if(hasLatencies(result))
+      out<<latencyNanoseconds(result.latencies->getMax());
+    else
+      out<<"null";
+    out<<"}"<<(++written != results.getSize() ? "," : "")<<std::endl;
+  }
+  out<<"]"<<std::endl;
+}
+
+// One row per non-empty bucket of every result with latencies, for graphing.
+inline void writeHistograms(std::ostream& out, const Vector<Result>& results)
+{
+  out<<"operation,container,element,size,lowest_ns,highest_ns,count"<<std::endl;
+  for(const Result& result : results)
+  {
+    if(!hasLatencies(result))
+      continue;
+    const LatencyHistogram& latencies = *result.latencies;
+    for(size_type index = 0; index != LatencyHistogram::bucketCount; index++)
+      if(latencies.getCountAt(index) != 0)
+        out<<result.operation<<','<<result.container<<','<<result.element<<','<<result.size<<','
+           <<latencyNanoseconds(LatencyHistogram::lowestValueAt(index))<<','
+           <<latencyNanoseconds(LatencyHistogram::highestValueAt(index))<<','
+           <<latencies.getCountAt(index)<<std::endl;
+  }
+}
+
+inline void writeResults(std::ostream& out, const Vector<Result>& results, const std::string& format)
+{
+  if(format == "csv")
+    writeCsv(out, results);
+  else if(format == "json")
+    writeJson(out, results);
+  else
+    writeTable(out, results);
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARK_H
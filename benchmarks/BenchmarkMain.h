@@ -0,0 +1,122 @@
+#ifndef AISDI_LINEAR_BENCHMARKMAIN_H
+#define AISDI_LINEAR_BENCHMARKMAIN_H
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Baseline.h"
+#include "Benchmark.h"
+#include "PerfCounters.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+namespace detail
+{
+
+template <typename Write>
+bool writeFile(const std::string& path, Write write)
+{
+  std::ofstream out(path.c_str());
+  write(out);
+  if(!out.flush())
+  {
+    std::cerr<<"Can't write "<<path<<std::endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+// The whole command line of a benchmark program, whose benchmarks
+// registerBenchmarks adds. Returns the exit code: 2 for a bad command line,
+// 1 for a failed write or a regression against --compare.
+inline int runBenchmarkMain(int argc, char** argv, void (*registerBenchmarks)(Registry&))
+{
+  Options options;
+  Baseline baseline;
+  try
+  {
+    options = parseOptions(argc, argv);
+    if(!options.baselineInput.empty())
+      baseline = loadBaseline(options.baselineInput);
+  }
+  catch(const std::invalid_argument& error)
+  {
+    std::cerr<<error.what()<<std::endl<<usage;
+    return 2;
+  }
+  catch(const std::runtime_error& error)
+  {
+    std::cerr<<error.what()<<std::endl;
+    return 2;
+  }
+
+  Registry registry;
+  registerBenchmarks(registry);
+
+  if(options.list)
+  {
+    for(const Case& benchmark : registry.getCases())
+      for(std::size_t size : options.sizes)
+      {
+        const std::string name = caseName(benchmark, size);
+        if(isSelected(options, name))
+          std::cout<<name<<std::endl;
+      }
+    return 0;
+  }
+
+  std::unique_ptr<PerfCounters> counters;
+  if(options.counters)
+  {
+    counters.reset(new PerfCounters());
+    if(!counters->getProblem().empty())
+      std::cerr<<"Some hardware counters are unavailable ("<<counters->getProblem()<<")"<<std::endl;
+  }
+  const Vector<Result> results = runSelected(registry, options, counters.get());
+
+  if(!options.histogramOutput.empty() and
+     !detail::writeFile(options.histogramOutput, [&](std::ostream& out) { writeHistograms(out, results); }))
+    return 1;
+  if(!options.baselineOutput.empty())
+  {
+    try
+    {
+      saveBaseline(options.baselineOutput, results);
+    }
+    catch(const std::runtime_error& error)
+    {
+      std::cerr<<error.what()<<std::endl;
+      return 1;
+    }
+  }
+  if(options.output.empty())
+    writeResults(std::cout, results, options.format);
+  else if(!detail::writeFile(options.output, [&](std::ostream& out) { writeResults(out, results, options.format); }))
+    return 1;
+
+  if(options.baselineInput.empty())
+    return 0;
+  const Vector<Comparison> comparisons = compareWithBaseline(baseline, results, options.alpha, options.threshold);
+  // the results may be going to stdout in a machine format
+  std::ostream& report = options.output.empty() and options.format != "table" ? std::cerr : std::cout;
+  report<<std::endl<<"Compared with "<<options.baselineInput<<":"<<std::endl;
+  writeComparison(report, comparisons);
+  return hasRegression(comparisons) ? 1 : 0;
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARKMAIN_H
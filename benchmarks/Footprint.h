@@ -0,0 +1,242 @@
+#ifndef AISDI_LINEAR_FOOTPRINT_H
+#define AISDI_LINEAR_FOOTPRINT_H
+
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "Vector.h"
+
+#include "AllocationCounter.h"
+#include "Benchmark.h"
+#include "LinearBenchmarks.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// Resident and proportional set sizes of the process, in bytes; pss is -1
+// where only /proc/self/statm could be read, both when neither could.
+struct ProcessMemory
+{
+  long long rss;
+  long long pss;
+};
+
+// From smaps_rollup (Linux 4.14 on), or the RSS from statm before it.
+inline ProcessMemory readProcessMemory(const std::string& rollup = "/proc/self/smaps_rollup")
+{
+  ProcessMemory memory = { -1, -1 };
+  std::ifstream in(rollup.c_str());
+  std::string line;
+  while(std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    std::string name;
+    long long kilobytes;
+    if(!(fields>>name>>kilobytes))
+      continue;
+    if(name == "Rss:")
+      memory.rss = kilobytes * 1024;
+    else if(name == "Pss:")
+      memory.pss = kilobytes * 1024;
+  }
+  if(memory.rss < 0)
+  {
+    std::ifstream statm("/proc/self/statm");
+    long long pages;
+    long long residentPages;
+    if(statm>>pages>>residentPages)
+      memory.rss = residentPages * sysconf(_SC_PAGESIZE);
+  }
+  return memory;
+}
+
+// Gives the free pages malloc holds back to the system, so that resident
+// memory is what live allocations pin.
+inline void trimHeap()
+{
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
+
+// The size word glibc keeps in front of every chunk, on top of its usable
+// size.
+const long long chunkHeaderBytes = sizeof(std::size_t);
+
+// What a container of size elements takes, after building it by appends
+// and after an erase-heavy phase that removes three of every four.
+// Heap bytes are usable sizes plus chunk headers, the peak adding only the
+// headers of the allocations that stayed; process deltas are against a
+// trimmed heap before building.
+struct Footprint
+{
+  std::string container;
+  std::string element;
+  size_type size;
+  // the container object and the elements in it, not their own heap data
+  size_type inlineBytes;
+  // built
+  long long heapBytes;
+  long long peakHeapBytes;
+  size_type allocations;
+  long long rssDelta;
+  long long pssDelta;
+  // after erasing
+  size_type keptSize;
+  long long keptHeapBytes;
+  long long keptRssDelta;
+};
+
+// Needs AllocationHooks.cpp linked in, or heap bytes stay 0.
+template <typename Container>
+Footprint measureFootprint(const std::string& container, const std::string& element, size_type size)
+{
+  using Type = typename Container::value_type;
+  Footprint footprint;
+  footprint.container = container;
+  footprint.element = element;
+  footprint.size = size;
+  footprint.inlineBytes = sizeof(Container) + size * sizeof(Type);
+
+  trimHeap();
+  const ProcessMemory before = readProcessMemory();
+  std::unique_ptr<Container> items;
+  long long liveBytes;
+  long long liveAllocations;
+  {
+    AllocationCounter counter;
+    items.reset(new Container());
+    fill(*items, size);
+    const AllocationCounts& built = counter.stop();
+    liveBytes = built.liveBytes;
+    liveAllocations = (long long)built.allocations - (long long)built.frees;
+    footprint.heapBytes = liveBytes + liveAllocations * chunkHeaderBytes;
+    footprint.peakHeapBytes = built.peakLiveBytes + liveAllocations * chunkHeaderBytes;
+    footprint.allocations = built.allocations;
+  }
+  const ProcessMemory built = readProcessMemory();
+  footprint.rssDelta = built.rss - before.rss;
+  footprint.pssDelta = before.pss >= 0 and built.pss >= 0 ? built.pss - before.pss : -1;
+
+  {
+    AllocationCounter counter;
+    size_type index = 0;
+    items->removeIf([&](const Type&)
+    {
+      return index++ % 4 != 0;
+    });
+    const AllocationCounts& erased = counter.stop();
+    liveBytes += erased.liveBytes;
+    liveAllocations += (long long)erased.allocations - (long long)erased.frees;
+  }
+  footprint.keptSize = items->getSize();
+  footprint.keptHeapBytes = liveBytes + liveAllocations * chunkHeaderBytes;
+  trimHeap();
+  footprint.keptRssDelta = readProcessMemory().rss - before.rss;
+  return footprint;
+}
+
+// Resident memory the kept elements pin that their heap bytes don't use:
+// free space malloc can't return between them. 0 when unknown.
+inline double fragmentation(const Footprint& footprint)
+{
+  if(footprint.keptRssDelta <= 0 or footprint.keptHeapBytes >= footprint.keptRssDelta)
+    return 0;
+  return 1 - (double)footprint.keptHeapBytes / footprint.keptRssDelta;
+}
+
+namespace detail
+{
+
+inline double perElement(long long bytes, size_type size)
+{
+  return size != 0 ? (double)bytes / size : 0;
+}
+
+}
+
+inline void writeFootprintTable(std::ostream& out, const Vector<Footprint>& footprints)
+{
+  out<<std::left<<std::setw(12)<<"container"<<std::setw(10)<<"element"<<std::right<<std::setw(10)<<"size"
+     <<std::setw(10)<<"inline"<<std::setw(10)<<"heap"<<std::setw(10)<<"peak"<<std::setw(10)<<"allocs"
+     <<std::setw(10)<<"rss"<<std::setw(10)<<"pss"<<std::setw(12)<<"kept heap"<<std::setw(12)<<"kept rss"
+     <<std::setw(8)<<"frag"<<std::endl;
+  for(const Footprint& footprint : footprints)
+  {
+    out<<std::left<<std::setw(12)<<footprint.container<<std::setw(10)<<footprint.element<<std::right
+       <<std::setw(10)<<footprint.size<<std::fixed<<std::setprecision(1)
+       <<std::setw(10)<<detail::perElement(footprint.inlineBytes, footprint.size)
+       <<std::setw(10)<<detail::perElement(footprint.heapBytes, footprint.size)
+       <<std::setw(10)<<detail::perElement(footprint.peakHeapBytes, footprint.size)
+       <<std::setw(10)<<detail::perElement(footprint.allocations, footprint.size)
+       <<std::setw(10)<<detail::perElement(footprint.rssDelta, footprint.size);
+    if(footprint.pssDelta >= 0)
+      out<<std::setw(10)<<detail::perElement(footprint.pssDelta, footprint.size);
+    else
+      out<<std::setw(10)<<"-";
+    out<<std::setw(12)<<detail::perElement(footprint.keptHeapBytes, footprint.keptSize)
+       <<std::setw(12)<<detail::perElement(footprint.keptRssDelta, footprint.keptSize)
+       <<std::setw(7)<<fragmentation(footprint) * 100<<"%"<<std::endl;
+  }
+  out<<"(bytes and allocations per element; kept: per element left after erasing 3 of every 4)"<<std::endl;
+}
+
+// Totals rather than per-element figures; pss_bytes is empty when unknown.
+inline void writeFootprintCsv(std::ostream& out, const Vector<Footprint>& footprints)
+{
+  out<<"container,element,size,inline_bytes,heap_bytes,peak_heap_bytes,allocations,rss_bytes,pss_bytes,"
+       "kept_size,kept_heap_bytes,kept_rss_bytes,fragmentation"<<std::endl;
+  for(const Footprint& footprint : footprints)
+  {
+    out<<footprint.container<<','<<footprint.element<<','<<footprint.size<<','<<footprint.inlineBytes<<','
+       <<footprint.heapBytes<<','<<footprint.peakHeapBytes<<','<<footprint.allocations<<','
+       <<footprint.rssDelta<<',';
+    if(footprint.pssDelta >= 0)
+      out<<footprint.pssDelta;
+    out<<','<<footprint.keptSize<<','<<footprint.keptHeapBytes<<','<<footprint.keptRssDelta<<','
+       <<fragmentation(footprint)<<std::endl;
+  }
+}
+
+// The fields of the CSV; pss_bytes is null when unknown.
+inline void writeFootprintJson(std::ostream& out, const Vector<Footprint>& footprints)
+{
+  out<<"["<<std::endl;
+  size_type written = 0;
+  for(const Footprint& footprint : footprints)
+  {
+    out<<"  {\"container\": "<<jsonString(footprint.container)<<", \"element\": "<<jsonString(footprint.element)
+       <<", \"size\": "<<footprint.size<<", \"inline_bytes\": "<<footprint.inlineBytes
+       <<", \"heap_bytes\": "<<footprint.heapBytes<<", \"peak_heap_bytes\": "<<footprint.peakHeapBytes
+       <<", \"allocations\": "<<footprint.allocations<<", \"rss_bytes\": "<<footprint.rssDelta
+       <<", \"pss_bytes\": ";
+    if(footprint.pssDelta >= 0)
+      out<<footprint.pssDelta;
+    else
+      out<<"null";
+    out<<", \"kept_size\": "<<footprint.keptSize<<", \"kept_heap_bytes\": "<<footprint.keptHeapBytes
+       <<", \"kept_rss_bytes\": "<<footprint.keptRssDelta<<", \"fragmentation\": "<<fragmentation(footprint)
+       <<"}"<<(++written != footprints.getSize() ? "," : "")<<std::endl;
+  }
+  out<<"]"<<std::endl;
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_FOOTPRINT_H
@@ -0,0 +1,190 @@
+#ifndef AISDI_LINEAR_LATENCYHISTOGRAM_H
+#define AISDI_LINEAR_LATENCYHISTOGRAM_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// A cheap timestamp for timing single operations: the TSC on x86, which
+// every CPU of the last decade runs at a constant rate, and steady_clock
+// nanoseconds elsewhere. Not serialising, so a few cycles of neighbouring
+// work may leak into a reading.
+inline std::uint64_t readTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Measured once, against steady_clock over about 20 ms.
+inline double ticksPerNanosecond()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  static const double ratio = []()
+  {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const std::uint64_t startTicks = readTicks();
+    Clock::time_point now;
+    do
+      now = Clock::now();
+    while(now - start < std::chrono::milliseconds(20));
+    const double ticks = (double)(readTicks() - startTicks);
+    return ticks / std::chrono::duration<double, std::nano>(now - start).count();
+  }();
+  return ratio;
+#else
+  return 1.0;
+#endif
+}
+
+// Log-linear histogram of tick counts in the style of HdrHistogram, in a
+// fixed array: values below subBucketCount are kept exactly, and every
+// power of two above is split into subBucketCount / 2 equal buckets, so a
+// recorded value is known to within 1 / 32 of itself. min and max are exact.
+class LatencyHistogram
+{
+public:
+  using size_type = std::size_t;
+
+  static const unsigned subBucketBits = 6;
+  static const size_type subBucketCount = size_type(1) << subBucketBits;
+  static const size_type bucketCount = (64 - subBucketBits + 1) * (subBucketCount / 2) + subBucketCount / 2;
+
+private:
+  std::uint64_t counts[bucketCount];
+  std::uint64_t total;
+  std::uint64_t minValue;
+  std::uint64_t maxValue;
+
+  static unsigned highestBit(std::uint64_t value)
+  {
+    return 63 - (unsigned)__builtin_clzll(value);
+  }
+
+public:
+  LatencyHistogram()
+  {
+    reset();
+  }
+
+  void reset()
+  {
+    for(std::uint64_t& count : counts)
+      count = 0;
+    total = 0;
+    minValue = ~std::uint64_t(0);
+    maxValue = 0;
+  }
+
+  static size_type indexOf(std::uint64_t value)
+  {
+    if(value < subBucketCount)
+      return (size_type)value;
+    // value has highestBit + 1 bits; keep the top subBucketBits of them
+    const unsigned shift = highestBit(value) - (subBucketBits - 1);
+    return (size_type)(shift * (subBucketCount / 2) + (value >> shift));
+  }
+
+  // The smallest value that lands in bucket index.
+  static std::uint64_t lowestValueAt(size_type index)
+  {
+    if(index < subBucketCount)
+      return index;
+    const size_type half = subBucketCount / 2;
+    const unsigned shift = (unsigned)(index / half - 1);
+    return (std::uint64_t)(index - shift * half) << shift;
+  }
+
+  // The biggest value that lands in bucket index.
+  static std::uint64_t highestValueAt(size_type index)
+  {
+    return index + 1 < bucketCount ? lowestValueAt(index + 1) - 1 : ~std::uint64_t(0);
+  }
+
+  void record(std::uint64_t value)
+  {
+    counts[indexOf(value)]++;
+    total++;
+    if(value < minValue)
+      minValue = value;
+    if(value > maxValue)
+      maxValue = value;
+  }
+
+  LatencyHistogram& operator+=(const LatencyHistogram& other)
+  {
+    for(size_type index = 0; index != bucketCount; index++)
+      counts[index] += other.counts[index];
+    total += other.total;
+    if(other.minValue < minValue)
+      minValue = other.minValue;
+    if(other.maxValue > maxValue)
+      maxValue = other.maxValue;
+    return *this;
+  }
+
+  std::uint64_t getCount() const
+  {
+    return total;
+  }
+
+  std::uint64_t getCountAt(size_type index) const
+  {
+    return counts[index];
+  }
+
+  // 0 when empty.
+  std::uint64_t getMin() const
+  {
+    return total != 0 ? minValue : 0;
+  }
+
+  std::uint64_t getMax() const
+  {
+    return maxValue;
+  }
+
+  // The smallest value at least percentile% of the recordings don't exceed,
+  // rounded up to the end of its bucket but never past the maximum.
+  std::uint64_t valueAtPercentile(double percentile) const
+  {
+    if(total == 0)
+      return 0;
+    std::uint64_t rank = (std::uint64_t)(percentile / 100.0 * total + 0.5);
+    if(rank == 0)
+      rank = 1;
+    if(rank > total)
+      rank = total;
+    std::uint64_t seen = 0;
+    for(size_type index = 0; index != bucketCount; index++)
+    {
+      seen += counts[index];
+      if(seen >= rank)
+      {
+        const std::uint64_t highest = highestValueAt(index);
+        return highest < maxValue ? highest : maxValue;
+      }
+    }
+    return maxValue;
+  }
+};
+
+}
+
+}
+
+#endif // AISDI_LINEAR_LATENCYHISTOGRAM_H
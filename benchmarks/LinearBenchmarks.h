@@ -0,0 +1,137 @@
+#ifndef AISDI_LINEAR_LINEARBENCHMARKS_H
+#define AISDI_LINEAR_LINEARBENCHMARKS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+#include "Benchmark.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// Element number index of a benchmarked container; types other than int
+// and std::string are built from the index, as the payloads of Payloads.h.
+template <typename Type>
+Type makeElement(size_type index)
+{
+  return Type(index);
+}
+
+template <>
+inline int makeElement<int>(size_type index)
+{
+  return (int)index;
+}
+
+// long enough to live on the heap, so copies cost an allocation
+template <>
+inline std::string makeElement<std::string>(size_type index)
+{
+  return "testujemy element numer " + std::to_string(index);
+}
+
+// Prepends and middle inserts shift the whole tail of a Vector, so they are
+// measured as this many operations on a container of the given size.
+const size_type shiftingOperations = 1000;
+
+template <typename Container>
+void fill(Container& container, size_type size)
+{
+  using Type = typename Container::value_type;
+  for(size_type index = 0; index != size; index++)
+    container.append(makeElement<Type>(index));
+}
+
+// append, prepend, insert-middle, erase-range, iterate and pop of one
+// container type, which needs the interface of Vector and LinkedList. All but
+// erase-range, a single call, time one element at a time.
+template <typename Container>
+void registerLinearBenchmarks(Registry& registry, const std::string& container, const std::string& element)
+{
+  using Type = typename Container::value_type;
+
+  registry.add("append", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    const Type item = makeElement<Type>(size);
+    measurement.timeEach(size, [&](size_type)
+    {
+      items.append(item);
+    });
+    doNotOptimize(items);
+  });
+
+  registry.add("prepend", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    fill(items, size);
+    const Type item = makeElement<Type>(size);
+    const size_type count = std::min(size, shiftingOperations);
+    measurement.timeEach(count, [&](size_type)
+    {
+      items.prepend(item);
+    });
+    doNotOptimize(items);
+  });
+
+  registry.add("insert-middle", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    fill(items, size);
+    const Type item = makeElement<Type>(size);
+    const size_type count = std::min(size, shiftingOperations);
+    // both containers' iterators stay put across inserts before them
+    const typename Container::const_iterator position = items.cbegin() + size / 2;
+    measurement.timeEach(count, [&](size_type)
+    {
+      items.insert(position, item);
+    });
+    doNotOptimize(items);
+  });
+
+  registry.add("erase-range", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    fill(items, size);
+    const typename Container::const_iterator first = items.cbegin() + size / 4;
+    const typename Container::const_iterator last = items.cbegin() + (size - size / 4);
+    measurement.time(size - 2 * (size / 4), [&]()
+    {
+      items.erase(first, last);
+    });
+    doNotOptimize(items);
+  });
+
+  registry.add("iterate", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    fill(items, size);
+    const Container& view = items;
+    auto item = view.begin();
+    measurement.timeEach(size, [&](size_type)
+    {
+      doNotOptimize(*item);
+      ++item;
+    });
+  });
+
+  registry.add("pop", container, element, [](Measurement& measurement, size_type size)
+  {
+    Container items;
+    fill(items, size);
+    measurement.timeEach(size, [&](size_type)
+    {
+      doNotOptimize(items.popLast());
+    });
+  });
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_LINEARBENCHMARKS_H
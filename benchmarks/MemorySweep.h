@@ -0,0 +1,252 @@
+#ifndef AISDI_LINEAR_MEMORYSWEEP_H
+#define AISDI_LINEAR_MEMORYSWEEP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "Benchmark.h"
+#include "LinearBenchmarks.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+struct CacheLevel
+{
+  unsigned level;
+  size_type bytes;
+};
+
+// "48K", "2048K", "32M" or plain bytes, as sysfs writes them; 0 if it isn't.
+inline size_type parseCacheSize(const std::string& text)
+{
+  char* end = nullptr;
+  const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+  if(end == text.c_str())
+    return 0;
+  const std::string unit(end);
+  if(unit.empty())
+    return value;
+  if(unit == "K")
+    return value << 10;
+  if(unit == "M")
+    return value << 20;
+  if(unit == "G")
+    return value << 30;
+  return 0;
+}
+
+// The data and unified caches of the CPU under root, by level; empty when
+// sysfs doesn't describe them, as in some containers.
+inline Vector<CacheLevel> detectDataCaches(const std::string& root = "/sys/devices/system/cpu/cpu0/cache")
+{
+  Vector<CacheLevel> caches;
+  for(unsigned index = 0; ; index++)
+  {
+    const std::string directory = root + "/index" + std::to_string(index) + "/";
+    std::ifstream levelFile((directory + "level").c_str());
+    std::ifstream typeFile((directory + "type").c_str());
+    std::ifstream sizeFile((directory + "size").c_str());
+    CacheLevel cache;
+    std::string type;
+    std::string size;
+    if(!(levelFile>>cache.level) or !(typeFile>>type) or !(sizeFile>>size))
+      break;
+    cache.bytes = parseCacheSize(size);
+    if(type != "Instruction" and cache.bytes != 0)
+      caches.append(cache);
+  }
+  CacheLevel* first = caches.data();
+  std::sort(first, first + caches.getSize(), [](const CacheLevel& a, const CacheLevel& b)
+  {
+    return a.level < b.level;
+  });
+  return caches;
+}
+
+struct MemoryTier
+{
+  std::string name;
+  size_type workingSetBytes;
+};
+
+// Caches assumed when none are detected.
+const CacheLevel fallbackCaches[] = { { 1, 32 << 10 }, { 2, 1 << 20 }, { 3, 8 << 20 } };
+
+// Biggest working set of the DRAM tier, unless the last cache is bigger
+// than half of it.
+const size_type maxDramWorkingSet = size_type(256) << 20;
+
+// One working set per level, half its size so neighbouring data and the
+// replacement policy leave room, and a DRAM one of four times the last
+// level: at most maxDramWorkingSet, at least twice the last level.
+inline Vector<MemoryTier> memoryTiers(const Vector<CacheLevel>& caches)
+{
+  Vector<MemoryTier> tiers;
+  for(const CacheLevel& cache : caches)
+    tiers.append({ "L" + std::to_string(cache.level), cache.bytes / 2 });
+  size_type last = 0;
+  for(const CacheLevel& cache : caches)
+    last = std::max(last, cache.bytes);
+  tiers.append({ "DRAM", std::max(2 * last, std::min(4 * last, maxDramWorkingSet)) });
+  return tiers;
+}
+
+// What a list element takes on the heap: its node in a glibc malloc chunk,
+// which adds a size word and rounds up to 16 bytes.
+template <typename Type>
+size_type listNodeBytes()
+{
+  const size_type node = sizeof(Type) + 2 * sizeof(void*) + sizeof(std::size_t);
+  return std::max<size_type>(32, (node + 15) / 16 * 16);
+}
+
+// Appends count elements whose nodes lie in random order in memory. It
+// frees as many node-sized blocks in shuffled order first; malloc hands
+// recently freed small blocks back last in, first out, so the nodes get
+// their addresses in shuffled order.
+template <typename Type>
+void fillScattered(LinkedList<Type>& items, size_type count, std::uint64_t seed = 1)
+{
+  const size_type nodeSize = sizeof(Type) + 2 * sizeof(void*);
+  Vector<void*> blocks = Vector<void*>::withCapacity(count);
+  for(size_type index = 0; index != count; index++)
+    blocks.append(::operator new(nodeSize));
+  void** first = blocks.data();
+  std::shuffle(first, first + count, std::mt19937_64(seed));
+  for(void* block : blocks)
+    ::operator delete(block);
+  fill(items, count);
+}
+
+// Fraction of neighbouring elements less than a cache line apart: near 1
+// for nodes allocated in order, near 0 for scattered ones.
+template <typename Container>
+double adjacentFraction(const Container& items)
+{
+  size_type adjacent = 0;
+  size_type pairs = 0;
+  const char* previous = nullptr;
+  for(auto item = items.begin(); item != items.end(); ++item)
+  {
+    const char* address = reinterpret_cast<const char*>(&*item);
+    if(previous != nullptr)
+    {
+      const std::ptrdiff_t distance = address - previous;
+      adjacent += distance > -64 and distance < 64;
+      pairs++;
+    }
+    previous = address;
+  }
+  return pairs != 0 ? (double)adjacent / pairs : 0;
+}
+
+// Walks every element in order and counts it as one operation each.
+template <typename Container>
+void timeTraversal(Measurement& measurement, const Container& items)
+{
+  using Type = typename Container::value_type;
+  measurement.time(items.getSize(), [&]()
+  {
+    Type sum = Type();
+    for(const Type& item : items)
+      sum += item;
+    doNotOptimize(sum);
+  });
+}
+
+// How well fillScattered worked for a working set: the adjacentFraction of
+// the last list it built at that size. It relies on malloc reusing freed
+// blocks last in, first out, which glibc does and e.g. sanitizer allocators
+// don't; near the in-order list's fraction, the nodes weren't scattered.
+struct ScatterCheck
+{
+  size_type workingSetBytes;
+  double adjacentFraction;
+};
+
+// Traversals of Vector<Type> and LinkedList<Type> whose sizes are working
+// sets in bytes, for sweeping them over the memory tiers:
+//  - sequential: in order, streaming a Vector and chasing the pointers of a
+//    list whose nodes were allocated in order, so mostly lie in order;
+//  - random: a Vector in a random order, which defeats the prefetcher;
+//  - shuffled-node: in order through a list whose nodes were scattered.
+// Each reports nanoseconds per element. With scatterChecks, shuffled-node
+// also keeps a ScatterCheck per working set there.
+template <typename Type>
+void registerMemorySweep(Registry& registry, const std::string& element,
+                         Vector<ScatterCheck>* scatterChecks = nullptr)
+{
+  registry.add("sequential", "Vector", element, [](Measurement& measurement, size_type bytes)
+  {
+    Vector<Type> items;
+    fill(items, std::max<size_type>(1, bytes / sizeof(Type)));
+    timeTraversal(measurement, items);
+  });
+
+  registry.add("random", "Vector", element, [](Measurement& measurement, size_type bytes)
+  {
+    Vector<Type> items;
+    const size_type count = std::max<size_type>(1, bytes / sizeof(Type));
+    fill(items, count);
+    const Type* data = items.data();
+    size_type range = 1;
+    while(range < count)
+      range *= 2;
+    // a full-period LCG modulo range visits every index below it once;
+    // computing the next one doesn't wait for the load
+    measurement.time(count, [&]()
+    {
+      Type sum = Type();
+      std::uint64_t state = 0;
+      for(size_type step = 0; step != range; step++)
+      {
+        state = (state * 6364136223846793005ull + 1442695040888963407ull) & (range - 1);
+        if(state < count)
+          sum += data[state];
+      }
+      doNotOptimize(sum);
+    });
+  });
+
+  registry.add("sequential", "LinkedList", element, [](Measurement& measurement, size_type bytes)
+  {
+    LinkedList<Type> items;
+    fill(items, std::max<size_type>(1, bytes / listNodeBytes<Type>()));
+    timeTraversal(measurement, items);
+  });
+
+  registry.add("shuffled-node", "LinkedList", element, [scatterChecks](Measurement& measurement, size_type bytes)
+  {
+    LinkedList<Type> items;
+    fillScattered(items, std::max<size_type>(1, bytes / listNodeBytes<Type>()));
+    timeTraversal(measurement, items);
+    if(scatterChecks == nullptr)
+      return;
+    const ScatterCheck check = { bytes, adjacentFraction(items) };
+    for(ScatterCheck& existing : *scatterChecks)
+      if(existing.workingSetBytes == bytes)
+      {
+        existing = check;
+        return;
+      }
+    scatterChecks->append(check);
+  });
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_MEMORYSWEEP_H
@@ -0,0 +1,132 @@
+#ifndef AISDI_LINEAR_PAYLOADS_H
+#define AISDI_LINEAR_PAYLOADS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// Bytes of plain data held in place, so the container copies all of them
+// with every shift or relocation, and the compiler may use memmove.
+template <std::size_t Bytes>
+struct TrivialPayload
+{
+  static_assert(Bytes >= sizeof(std::uint32_t), "A payload holds at least its id");
+
+  unsigned char bytes[Bytes];
+
+  TrivialPayload() = default;
+
+  explicit TrivialPayload(std::size_t index)
+  {
+    std::memset(bytes, 0, Bytes);
+    const std::uint32_t id = (std::uint32_t)index;
+    std::memcpy(bytes, &id, sizeof(id));
+  }
+
+  std::uint32_t getId() const
+  {
+    std::uint32_t id;
+    std::memcpy(&id, bytes, sizeof(id));
+    return id;
+  }
+};
+
+// Bytes of data on the heap, like a record with a std::string or
+// std::vector member: a move steals the buffer, a copy into an empty
+// payload allocates one and a copy into a full one reuses it.
+template <std::size_t Bytes>
+class OwningPayload
+{
+  static_assert(Bytes >= sizeof(std::uint32_t), "A payload holds at least its id");
+
+  // null when default-constructed or moved from
+  unsigned char* bytes;
+
+public:
+  OwningPayload()
+    : bytes(nullptr)
+  {}
+
+  explicit OwningPayload(std::size_t index)
+    : bytes(new unsigned char[Bytes])
+  {
+    std::memset(bytes, 0, Bytes);
+    const std::uint32_t id = (std::uint32_t)index;
+    std::memcpy(bytes, &id, sizeof(id));
+  }
+
+  OwningPayload(const OwningPayload& other)
+    : bytes(nullptr)
+  {
+    *this = other;
+  }
+
+  OwningPayload(OwningPayload&& other) noexcept
+    : bytes(other.bytes)
+  {
+    other.bytes = nullptr;
+  }
+
+  ~OwningPayload()
+  {
+    delete [] bytes;
+  }
+
+  OwningPayload& operator=(const OwningPayload& other)
+  {
+    if(other.bytes == nullptr)
+    {
+      delete [] bytes;
+      bytes = nullptr;
+    }
+    else if(this != &other)
+    {
+      if(bytes == nullptr)
+        bytes = new unsigned char[Bytes];
+      std::memcpy(bytes, other.bytes, Bytes);
+    }
+    return *this;
+  }
+
+  OwningPayload& operator=(OwningPayload&& other) noexcept
+  {
+    if(this != &other)
+    {
+      delete [] bytes;
+      bytes = other.bytes;
+      other.bytes = nullptr;
+    }
+    return *this;
+  }
+
+  // 0 when there's nothing to read.
+  std::uint32_t getId() const
+  {
+    std::uint32_t id = 0;
+    if(bytes != nullptr)
+      std::memcpy(&id, bytes, sizeof(id));
+    return id;
+  }
+
+  bool isEmpty() const
+  {
+    return bytes == nullptr;
+  }
+};
+
+static_assert(std::is_trivially_copyable<TrivialPayload<64>>::value, "TrivialPayload must stay trivial");
+static_assert(!std::is_trivially_copyable<OwningPayload<64>>::value, "OwningPayload must not be trivial");
+
+}
+
+}
+
+#endif // AISDI_LINEAR_PAYLOADS_H
@@ -0,0 +1,214 @@
+#ifndef AISDI_LINEAR_PERFCOUNTERS_H
+#define AISDI_LINEAR_PERFCOUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+enum Counter
+{
+  cyclesCounter,
+  instructionsCounter,
+  l1dMissesCounter,
+  llcMissesCounter,
+  branchMissesCounter,
+  dtlbMissesCounter,
+  counterCount
+};
+
+inline const char* counterName(std::size_t counter)
+{
+  static const char* const names[counterCount] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+  };
+  return names[counter];
+}
+
+// Event totals of one measured region, or of many added together.
+struct CounterValues
+{
+  double values[counterCount];
+
+  CounterValues()
+  {
+    for(double& value : values)
+      value = 0;
+  }
+
+  CounterValues& operator+=(const CounterValues& other)
+  {
+    for(std::size_t counter = 0; counter != counterCount; counter++)
+      values[counter] += other.values[counter];
+    return *this;
+  }
+};
+
+// Hardware event counters of the calling thread, user space only, read
+// through Linux perf_event_open. Every event is opened on its own, so a CPU,
+// VM or perf_event_paranoid setting that lacks some of them still gets the
+// rest; isAvailable() tells which. When the kernel multiplexes the events
+// the counts are scaled up to the time they were enabled. Elsewhere than on
+// Linux nothing is available.
+class PerfCounters
+{
+  int descriptors[counterCount];
+  std::string problem;
+
+#ifdef __linux__
+  static bool eventOf(std::size_t counter, std::uint32_t& type, std::uint64_t& config)
+  {
+    const std::uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch(counter)
+    {
+      case cyclesCounter:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_CPU_CYCLES;
+        return true;
+      case instructionsCounter:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_INSTRUCTIONS;
+        return true;
+      case l1dMissesCounter:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_L1D | readMiss;
+        return true;
+      case llcMissesCounter:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_LL | readMiss;
+        return true;
+      case branchMissesCounter:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_BRANCH_MISSES;
+        return true;
+      case dtlbMissesCounter:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_DTLB | readMiss;
+        return true;
+    }
+    return false;
+  }
+
+  static int openEvent(std::uint32_t type, std::uint64_t config)
+  {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+  }
+#endif
+
+public:
+  PerfCounters()
+  {
+    for(std::size_t counter = 0; counter != counterCount; counter++)
+    {
+      descriptors[counter] = -1;
+#ifdef __linux__
+      std::uint32_t type;
+      std::uint64_t config;
+      if(eventOf(counter, type, config))
+        descriptors[counter] = openEvent(type, config);
+      if(descriptors[counter] < 0 and problem.empty())
+        problem = std::string(counterName(counter)) + ": " + std::strerror(errno);
+#endif
+    }
+#ifndef __linux__
+    problem = "perf_event_open needs Linux";
+#endif
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters()
+  {
+#ifdef __linux__
+    for(int descriptor : descriptors)
+      if(descriptor >= 0)
+        close(descriptor);
+#endif
+  }
+
+  bool isAvailable(std::size_t counter) const
+  {
+    return descriptors[counter] >= 0;
+  }
+
+  bool isAnyAvailable() const
+  {
+    for(int descriptor : descriptors)
+      if(descriptor >= 0)
+        return true;
+    return false;
+  }
+
+  // Why the first missing counter couldn't be opened; empty when none is.
+  const std::string& getProblem() const
+  {
+    return problem;
+  }
+
+  void start()
+  {
+#ifdef __linux__
+    for(int descriptor : descriptors)
+      if(descriptor >= 0)
+      {
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+  }
+
+  // Adds what was counted since start() to totals.
+  void stop(CounterValues& totals)
+  {
+#ifdef __linux__
+    for(int descriptor : descriptors)
+      if(descriptor >= 0)
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    for(std::size_t counter = 0; counter != counterCount; counter++)
+    {
+      // value, time enabled, time running
+      std::uint64_t reading[3];
+      if(descriptors[counter] < 0 or
+         read(descriptors[counter], reading, sizeof(reading)) != (ssize_t)sizeof(reading))
+        continue;
+      double value = (double)reading[0];
+      if(reading[2] != 0 and reading[2] < reading[1])
+        value *= (double)reading[1] / reading[2];
+      totals.values[counter] += value;
+    }
+#else
+    (void)totals;
+#endif
+  }
+};
+
+}
+
+}
+
+#endif // AISDI_LINEAR_PERFCOUNTERS_H
@@ -0,0 +1,265 @@
+#ifndef AISDI_LINEAR_STDADAPTERS_H
+#define AISDI_LINEAR_STDADAPTERS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <vector>
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// Gives std::vector or std::deque the interface registerLinearBenchmarks,
+// replayTrace and measureFootprint use. Its iterators are positions, like
+// aisdi::Vector's, so they survive the insertions that invalidate the
+// standard ones.
+template <typename Container>
+class StdIndexedAdapter
+{
+public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename Container::value_type;
+
+  class ConstIterator
+  {
+    const Container* items;
+    size_type index;
+
+  public:
+    ConstIterator(const Container* items_, size_type index_)
+      : items(items_), index(index_)
+    {}
+
+    const value_type& operator*() const
+    {
+      return (*items)[index];
+    }
+
+    ConstIterator& operator++()
+    {
+      index++;
+      return *this;
+    }
+
+    ConstIterator operator+(difference_type d) const
+    {
+      return ConstIterator(items, index + d);
+    }
+
+    bool operator==(const ConstIterator& other) const
+    {
+      return index == other.index and items == other.items;
+    }
+
+    bool operator!=(const ConstIterator& other) const
+    {
+      return !(*this == other);
+    }
+
+    size_type getIndex() const
+    {
+      return index;
+    }
+  };
+
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;
+
+private:
+  Container items;
+
+public:
+  size_type getSize() const
+  {
+    return items.size();
+  }
+
+  void append(const value_type& item)
+  {
+    items.push_back(item);
+  }
+
+  void prepend(const value_type& item)
+  {
+    items.insert(items.begin(), item);
+  }
+
+  void insert(const const_iterator& position, const value_type& item)
+  {
+    items.insert(items.begin() + position.getIndex(), item);
+  }
+
+  void erase(const const_iterator& position)
+  {
+    items.erase(items.begin() + position.getIndex());
+  }
+
+  void erase(const const_iterator& first, const const_iterator& last)
+  {
+    items.erase(items.begin() + first.getIndex(), items.begin() + last.getIndex());
+  }
+
+  value_type popFirst()
+  {
+    value_type item = items.front();
+    items.erase(items.begin());
+    return item;
+  }
+
+  template <typename Predicate>
+  size_type removeIf(Predicate predicate)
+  {
+    const auto kept = std::remove_if(items.begin(), items.end(), predicate);
+    const size_type removed = items.end() - kept;
+    items.erase(kept, items.end());
+    return removed;
+  }
+
+  value_type popLast()
+  {
+    value_type item = items.back();
+    items.pop_back();
+    return item;
+  }
+
+  const_iterator cbegin() const
+  {
+    return ConstIterator(&items, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(&items, items.size());
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+// The same for std::list, whose own iterators already stay valid.
+template <typename Type>
+class StdListAdapter
+{
+public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = Type;
+
+  class ConstIterator : public std::list<Type>::const_iterator
+  {
+  public:
+    ConstIterator(typename std::list<Type>::const_iterator position)
+      : std::list<Type>::const_iterator(position)
+    {}
+
+    // walks, as aisdi::LinkedList does
+    ConstIterator operator+(difference_type d) const
+    {
+      return ConstIterator(std::next(static_cast<const typename std::list<Type>::const_iterator&>(*this), d));
+    }
+  };
+
+  using const_iterator = ConstIterator;
+  using iterator = ConstIterator;
+
+private:
+  std::list<Type> items;
+
+public:
+  size_type getSize() const
+  {
+    return items.size();
+  }
+
+  void append(const Type& item)
+  {
+    items.push_back(item);
+  }
+
+  void prepend(const Type& item)
+  {
+    items.push_front(item);
+  }
+
+  void insert(const const_iterator& position, const Type& item)
+  {
+    items.insert(position, item);
+  }
+
+  void erase(const const_iterator& position)
+  {
+    items.erase(position);
+  }
+
+  void erase(const const_iterator& first, const const_iterator& last)
+  {
+    items.erase(first, last);
+  }
+
+  Type popFirst()
+  {
+    Type item = items.front();
+    items.pop_front();
+    return item;
+  }
+
+  template <typename Predicate>
+  size_type removeIf(Predicate predicate)
+  {
+    const size_type before = items.size();
+    items.remove_if(predicate);
+    return before - items.size();
+  }
+
+  Type popLast()
+  {
+    Type item = items.back();
+    items.pop_back();
+    return item;
+  }
+
+  const_iterator cbegin() const
+  {
+    return items.cbegin();
+  }
+
+  const_iterator cend() const
+  {
+    return items.cend();
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+template <typename Type>
+using StdVectorAdapter = StdIndexedAdapter<std::vector<Type>>;
+
+template <typename Type>
+using StdDequeAdapter = StdIndexedAdapter<std::deque<Type>>;
+
+}
+
+}
+
+#endif // AISDI_LINEAR_STDADAPTERS_H
@@ -0,0 +1,272 @@
+#ifndef AISDI_LINEAR_THREADEDBENCHMARK_H
+#define AISDI_LINEAR_THREADEDBENCHMARK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "CacheLine.h"
+#include "Vector.h"
+
+#include "Benchmark.h"
+#include "LinearBenchmarks.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// The CPUs this process may run on, in order; just CPU 0 where the
+// affinity can't be read.
+inline Vector<int> allowedCpus()
+{
+  Vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    for(int cpu = 0; cpu != CPU_SETSIZE; cpu++)
+      if(CPU_ISSET(cpu, &set))
+        cpus.append(cpu);
+  if(cpus.isEmpty())
+    cpus.append(0);
+  return cpus;
+}
+
+// false when the thread stays where the scheduler puts it.
+inline bool pinCurrentThread(int cpu)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// How the threads of a run share their containers.
+enum ThreadingMode
+{
+  // each allocates its own container
+  ownContainers,
+  // each uses its own from one array, headers next to each other
+  packedContainers,
+  // the same, every header on cache lines of its own
+  paddedContainers,
+  // all use one container behind a mutex
+  sharedContainer,
+  threadingModeCount
+};
+
+inline const char* threadingModeName(std::size_t mode)
+{
+  static const char* const names[threadingModeCount] = { "own", "packed", "padded", "shared" };
+  return mode < threadingModeCount ? names[mode] : "?";
+}
+
+namespace detail
+{
+
+// Slots in one cache-line aligned block, constructed in place.
+template <typename Slot>
+class SlotArray
+{
+  void* memory;
+  size_type count;
+
+public:
+  explicit SlotArray(size_type count_)
+    : memory(nullptr), count(0)
+  {
+    if(posix_memalign(&memory, aisdi::detail::cacheLineSize, count_ * sizeof(Slot)) != 0)
+      throw std::bad_alloc();
+    for(; count != count_; count++)
+      new (&(*this)[count]) Slot();
+  }
+
+  SlotArray(const SlotArray&) = delete;
+  SlotArray& operator=(const SlotArray&) = delete;
+
+  ~SlotArray()
+  {
+    for(size_type index = 0; index != count; index++)
+      (*this)[index].~Slot();
+    std::free(memory);
+  }
+
+  Slot& operator[](size_type index)
+  {
+    return static_cast<Slot*>(memory)[index];
+  }
+};
+
+template <typename Container>
+Container& containerIn(Container& slot)
+{
+  return slot;
+}
+
+template <typename Container>
+Container& containerIn(aisdi::detail::CacheLinePadded<Container>& slot)
+{
+  return slot.value;
+}
+
+struct NoLock
+{
+  void lock()
+  {}
+
+  void unlock()
+  {}
+};
+
+// Rounds of appending size elements, then popping them all.
+template <typename Container, typename Lock>
+void churn(Container& items, size_type size, size_type rounds, Lock& lock)
+{
+  using Type = typename Container::value_type;
+  const Type item = makeElement<Type>(size);
+  for(size_type round = 0; round != rounds; round++)
+  {
+    for(size_type index = 0; index != size; index++)
+    {
+      std::lock_guard<Lock> guard(lock);
+      items.append(item);
+    }
+    for(size_type index = 0; index != size; index++)
+    {
+      std::lock_guard<Lock> guard(lock);
+      doNotOptimize(items.popLast());
+    }
+  }
+}
+
+// Holds the threads until all are ready, then lets them go at once.
+class StartGate
+{
+  std::mutex mutex;
+  std::condition_variable changed;
+  size_type ready;
+  bool open;
+
+public:
+  StartGate()
+    : ready(0), open(false)
+  {}
+
+  void arriveAndWait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ready++;
+    changed.notify_all();
+    changed.wait(lock, [this]() { return open; });
+  }
+
+  void waitForAll(size_type threads)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&]() { return ready == threads; });
+  }
+
+  void openGate()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    open = true;
+    changed.notify_all();
+  }
+};
+
+}
+
+struct ThreadedRun
+{
+  // from opening the start gate until the last thread finished
+  double nanoseconds;
+  // every thread got its CPU
+  bool pinned;
+};
+
+// Runs threads threads of rounds rounds of churn over size elements each,
+// thread i pinned to cpus[i % cpus.size()] unless cpus is empty. The
+// threads are started, and their containers of the packed and padded modes
+// built, before the clock starts.
+template <typename Container>
+ThreadedRun runThreaded(ThreadingMode mode, size_type threads, size_type size, size_type rounds,
+                        const Vector<int>& cpus)
+{
+  detail::StartGate gate;
+  std::unique_ptr<detail::SlotArray<Container>> packed;
+  std::unique_ptr<detail::SlotArray<aisdi::detail::CacheLinePadded<Container>>> padded;
+  std::unique_ptr<Container> shared;
+  std::mutex sharedLock;
+  if(mode == packedContainers)
+    packed.reset(new detail::SlotArray<Container>(threads));
+  else if(mode == paddedContainers)
+    padded.reset(new detail::SlotArray<aisdi::detail::CacheLinePadded<Container>>(threads));
+  else if(mode == sharedContainer)
+    shared.reset(new Container());
+
+  Vector<char> pinned;
+  for(size_type thread = 0; thread != threads; thread++)
+    pinned.append(cpus.isEmpty());
+  char* pinnedFlags = pinned.data();
+
+  // std::thread can only be moved, which Vector doesn't do
+  std::unique_ptr<std::thread[]> workers(new std::thread[threads]);
+  for(size_type thread = 0; thread != threads; thread++)
+    workers[thread] = std::thread([&, thread]()
+    {
+      if(!cpus.isEmpty())
+        pinnedFlags[thread] = pinCurrentThread(*(cpus.begin() + (thread % cpus.getSize())));
+      detail::NoLock noLock;
+      if(mode == ownContainers)
+      {
+        Container items;
+        gate.arriveAndWait();
+        detail::churn(items, size, rounds, noLock);
+      }
+      else if(mode == packedContainers)
+      {
+        gate.arriveAndWait();
+        detail::churn(detail::containerIn((*packed)[thread]), size, rounds, noLock);
+      }
+      else if(mode == paddedContainers)
+      {
+        gate.arriveAndWait();
+        detail::churn(detail::containerIn((*padded)[thread]), size, rounds, noLock);
+      }
+      else
+      {
+        gate.arriveAndWait();
+        detail::churn(*shared, size, rounds, sharedLock);
+      }
+    });
+
+  gate.waitForAll(threads);
+  const Clock::time_point start = Clock::now();
+  gate.openGate();
+  for(size_type thread = 0; thread != threads; thread++)
+    workers[thread].join();
+  const Clock::time_point end = Clock::now();
+
+  ThreadedRun run;
+  run.nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+  run.pinned = true;
+  for(char flag : pinned)
+    run.pinned = run.pinned and flag;
+  return run;
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_THREADEDBENCHMARK_H
@@ -0,0 +1,467 @@
+#ifndef AISDI_LINEAR_TRACE_H
+#define AISDI_LINEAR_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "LatencyHistogram.h"
+#include "LinearBenchmarks.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+// What a trace record does to the container. position and value are used
+// as noted; value identifies an element, which replay rebuilds with
+// makeElement.
+enum TraceOperation : std::uint8_t
+{
+  traceAppend,      // value
+  tracePrepend,     // value
+  traceInsert,      // position, value
+  traceErase,       // position
+  traceEraseRange,  // position, value: how many
+  tracePopFirst,
+  tracePopLast,
+  traceScan,        // reads every element
+  traceOperationCount
+};
+
+inline const char* traceOperationName(std::size_t operation)
+{
+  static const char* const names[traceOperationCount] = {
+    "append", "prepend", "insert", "erase", "erase-range", "pop-first", "pop-last", "scan"
+  };
+  return operation < traceOperationCount ? names[operation] : "?";
+}
+
+struct TraceRecord
+{
+  TraceOperation operation;
+  std::uint64_t position;
+  std::uint64_t value;
+};
+
+namespace detail
+{
+
+inline bool traceHasPosition(TraceOperation operation)
+{
+  return operation == traceInsert or operation == traceErase or operation == traceEraseRange;
+}
+
+inline bool traceHasValue(TraceOperation operation)
+{
+  return operation == traceAppend or operation == tracePrepend or operation == traceInsert or
+         operation == traceEraseRange;
+}
+
+// Every trace file starts with it; the last byte is the format version.
+const char traceMagic[8] = { 'A', 'I', 'S', 'D', 'I', 'T', 'R', 1 };
+
+const std::size_t traceBufferSize = 1 << 16;
+
+}
+
+// Writes a trace file: the magic, then per record its operation byte and
+// those of position and value it uses as LEB128 varints, so the common
+// append of a small value id takes two bytes. Buffered; throws
+// std::runtime_error when the file can't be written.
+class TraceWriter
+{
+  std::ofstream out;
+  std::string path;
+  std::unique_ptr<char[]> buffer;
+  std::size_t used;
+  std::uint64_t count;
+
+  void put(std::uint64_t number)
+  {
+    while(number >= 0x80)
+    {
+      buffer[used++] = (char)((number & 0x7f) | 0x80);
+      number >>= 7;
+    }
+    buffer[used++] = (char)number;
+  }
+
+  void drain()
+  {
+    if(!out.write(buffer.get(), used))
+      throw std::runtime_error("Can't write trace " + path);
+    used = 0;
+  }
+
+public:
+  // Longest encoding of a record: the operation and two 10-byte varints.
+  static const std::size_t maxRecordSize = 21;
+
+  explicit TraceWriter(const std::string& path_)
+    : out(path_.c_str(), std::ios::binary | std::ios::trunc), path(path_),
+      buffer(new char[detail::traceBufferSize]), used(0), count(0)
+  {
+    if(!out or !out.write(detail::traceMagic, sizeof(detail::traceMagic)))
+      throw std::runtime_error("Can't write trace " + path);
+  }
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  // Whatever close() didn't get to is written, errors ignored.
+  ~TraceWriter()
+  {
+    if(used != 0)
+      out.write(buffer.get(), used);
+  }
+
+  void write(TraceOperation operation, std::uint64_t position = 0, std::uint64_t value = 0)
+  {
+    if(used + maxRecordSize > detail::traceBufferSize)
+      drain();
+    buffer[used++] = (char)operation;
+    if(detail::traceHasPosition(operation))
+      put(position);
+    if(detail::traceHasValue(operation))
+      put(value);
+    count++;
+  }
+
+  void write(const TraceRecord& record)
+  {
+    write(record.operation, record.position, record.value);
+  }
+
+  void close()
+  {
+    drain();
+    if(!out.flush())
+      throw std::runtime_error("Can't write trace " + path);
+    out.close();
+  }
+
+  std::uint64_t getCount() const
+  {
+    return count;
+  }
+};
+
+// Streams the records of a trace file through a fixed buffer, so a trace
+// of any length replays in constant memory. Throws std::runtime_error when
+// the file can't be read, isn't a trace or is cut off mid-record.
+class TraceReader
+{
+  std::ifstream in;
+  std::string path;
+  std::unique_ptr<char[]> buffer;
+  std::size_t position;
+  std::size_t available;
+
+  bool refill()
+  {
+    if(!in)
+      return false;
+    in.read(buffer.get(), detail::traceBufferSize);
+    available = (std::size_t)in.gcount();
+    position = 0;
+    if(in.bad())
+      throw std::runtime_error("Can't read trace " + path);
+    return available != 0;
+  }
+
+  bool getByte(unsigned char& byte)
+  {
+    if(position == available and !refill())
+      return false;
+    byte = (unsigned char)buffer[position++];
+    return true;
+  }
+
+  std::uint64_t get()
+  {
+    std::uint64_t number = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+      unsigned char byte;
+      if(!getByte(byte))
+        throw std::runtime_error(path + " ends in the middle of a record");
+      number |= (std::uint64_t)(byte & 0x7f) << shift;
+      if((byte & 0x80) == 0)
+        return number;
+    }
+    throw std::runtime_error(path + " has a malformed number");
+  }
+
+public:
+  explicit TraceReader(const std::string& path_)
+    : in(path_.c_str(), std::ios::binary), path(path_), buffer(new char[detail::traceBufferSize]),
+      position(0), available(0)
+  {
+    if(!in)
+      throw std::runtime_error("Can't read trace " + path);
+    char magic[sizeof(detail::traceMagic)];
+    if(!in.read(magic, sizeof(magic)) or std::memcmp(magic, detail::traceMagic, sizeof(magic)) != 0)
+      throw std::runtime_error(path + " is not a container trace");
+  }
+
+  // false at the end of the trace.
+  bool next(TraceRecord& record)
+  {
+    unsigned char operation;
+    if(!getByte(operation))
+      return false;
+    if(operation >= traceOperationCount)
+      throw std::runtime_error(path + " has an unknown operation");
+    record.operation = (TraceOperation)operation;
+    record.position = detail::traceHasPosition(record.operation) ? get() : 0;
+    record.value = detail::traceHasValue(record.operation) ? get() : 0;
+    return true;
+  }
+};
+
+// The id a recorded element is logged as.
+inline std::uint64_t traceValueId(int value)
+{
+  return (std::uint64_t)(std::int64_t)value;
+}
+
+// Strings replay as makeElement<std::string>(id), so only their number of
+// distinct values survives, not their contents.
+inline std::uint64_t traceValueId(const std::string& value)
+{
+  return std::hash<std::string>()(value);
+}
+
+namespace detail
+{
+
+// The index of an iterator: walked to on a LinkedList, read off a Vector's.
+template <typename Container>
+struct TraceIndex
+{
+  static std::uint64_t of(const Container& items, typename Container::const_iterator position)
+  {
+    std::uint64_t index = 0;
+    for(auto walk = items.cbegin(); walk != position; ++walk)
+      index++;
+    return index;
+  }
+};
+
+template <typename Type, typename Stats>
+struct TraceIndex<Vector<Type, Stats>>
+{
+  static std::uint64_t of(const Vector<Type, Stats>&, typename Vector<Type, Stats>::const_iterator position)
+  {
+    return position.index;
+  }
+};
+
+}
+
+// A Vector or LinkedList that logs every modification to a trace, for
+// dropping in where production traffic runs. Reads through iterators
+// aren't seen; code that wants its scans in the trace calls scan().
+template <typename Container>
+class TracingContainer : public Container
+{
+  TraceWriter& trace;
+
+  std::uint64_t indexOf(const typename Container::const_iterator& position) const
+  {
+    return detail::TraceIndex<Container>::of(*this, position);
+  }
+
+public:
+  using value_type = typename Container::value_type;
+  using const_iterator = typename Container::const_iterator;
+
+  explicit TracingContainer(TraceWriter& trace_)
+    : trace(trace_)
+  {}
+
+  void append(const value_type& item)
+  {
+    trace.write(traceAppend, 0, traceValueId(item));
+    Container::append(item);
+  }
+
+  void prepend(const value_type& item)
+  {
+    trace.write(tracePrepend, 0, traceValueId(item));
+    Container::prepend(item);
+  }
+
+  void insert(const const_iterator& position, const value_type& item)
+  {
+    trace.write(traceInsert, indexOf(position), traceValueId(item));
+    Container::insert(position, item);
+  }
+
+  void erase(const const_iterator& position)
+  {
+    trace.write(traceErase, indexOf(position));
+    Container::erase(position);
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded)
+  {
+    const std::uint64_t first = indexOf(firstIncluded);
+    trace.write(traceEraseRange, first, indexOf(lastExcluded) - first);
+    Container::erase(firstIncluded, lastExcluded);
+  }
+
+  value_type popFirst()
+  {
+    trace.write(tracePopFirst);
+    return Container::popFirst();
+  }
+
+  value_type popLast()
+  {
+    trace.write(tracePopLast);
+    return Container::popLast();
+  }
+
+  // Calls visit on every element, in order.
+  template <typename Visit>
+  void scan(Visit visit) const
+  {
+    trace.write(traceScan);
+    for(auto item = this->cbegin(); item != this->cend(); ++item)
+      visit(*item);
+  }
+};
+
+namespace detail
+{
+
+inline bool traceRecordFits(const TraceRecord& record, std::uint64_t size)
+{
+  switch(record.operation)
+  {
+    case traceInsert:
+      return record.position <= size;
+    case traceErase:
+      return record.position < size;
+    case traceEraseRange:
+      return record.value <= size and record.position <= size - record.value;
+    case tracePopFirst:
+    case tracePopLast:
+      return size != 0;
+    default:
+      return true;
+  }
+}
+
+}
+
+// What replaying a trace measured: the count and latency histogram, in
+// ticks, of every operation, and the time they took together. Decoding the
+// trace isn't timed.
+struct ReplayResult
+{
+  std::uint64_t operations;
+  double nanoseconds;
+  std::uint64_t counts[traceOperationCount];
+  std::shared_ptr<LatencyHistogram> latencies;
+
+  ReplayResult()
+    : operations(0), nanoseconds(0), counts(), latencies(new LatencyHistogram[traceOperationCount],
+                                                         std::default_delete<LatencyHistogram[]>())
+  {}
+
+  const LatencyHistogram& getLatencies(std::size_t operation) const
+  {
+    return latencies.get()[operation];
+  }
+
+  double operationsPerSecond() const
+  {
+    return nanoseconds > 0 ? operations / nanoseconds * 1e9 : 0;
+  }
+};
+
+// Runs every record of trace against items, which needs the interface of
+// Vector and LinkedList. Positions become iterators by cbegin() + position,
+// which walks a list: that walk is part of what the list costs. Throws
+// std::runtime_error when a record doesn't fit the container, e.g. a trace
+// recorded from one that didn't start empty.
+template <typename Container>
+ReplayResult replayTrace(TraceReader& trace, Container& items)
+{
+  using Type = typename Container::value_type;
+  ReplayResult result;
+  std::uint64_t ticks = 0;
+  TraceRecord record;
+  while(trace.next(record))
+  {
+    if(!detail::traceRecordFits(record, items.getSize()))
+      throw std::runtime_error(std::string("Trace ") + traceOperationName(record.operation) +
+                               " doesn't fit a container of " + std::to_string(items.getSize()));
+    // built before the clock starts, like the benchmarks' elements
+    const Type item = makeElement<Type>((size_type)record.value);
+
+    const std::uint64_t start = readTicks();
+    switch(record.operation)
+    {
+      case traceAppend:
+        items.append(item);
+        break;
+      case tracePrepend:
+        items.prepend(item);
+        break;
+      case traceInsert:
+        items.insert(items.cbegin() + record.position, item);
+        break;
+      case traceErase:
+        items.erase(items.cbegin() + record.position);
+        break;
+      case traceEraseRange:
+      {
+        const typename Container::const_iterator first = items.cbegin() + record.position;
+        items.erase(first, first + record.value);
+        break;
+      }
+      case tracePopFirst:
+        doNotOptimize(items.popFirst());
+        break;
+      case tracePopLast:
+        doNotOptimize(items.popLast());
+        break;
+      case traceScan:
+      {
+        const Container& view = items;
+        for(auto element = view.begin(); element != view.end(); ++element)
+          doNotOptimize(*element);
+        break;
+      }
+      case traceOperationCount:
+        break;
+    }
+    const std::uint64_t elapsed = readTicks() - start;
+
+    ticks += elapsed;
+    result.latencies.get()[record.operation].record(elapsed);
+    result.counts[record.operation]++;
+    result.operations++;
+  }
+  result.nanoseconds = ticks / ticksPerNanosecond();
+  return result;
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_TRACE_H
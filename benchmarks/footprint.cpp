@@ -0,0 +1,108 @@
+// Reports the memory every container takes per element: heap bytes through
+// the allocation hooks, resident and proportional set size from
+// /proc/self/smaps_rollup, and what stays pinned after erasing most of it.
+
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "Benchmark.h"
+#include "Footprint.h"
+#include "Payloads.h"
+#include "StdAdapters.h"
+
+namespace
+{
+
+using aisdi::bench::size_type;
+
+const char* const footprintUsage =
+  "options:\n"
+  "  --filter=PATTERN   container/element/size, * matches anything;\n"
+  "                     repeat for alternatives (default: all)\n"
+  "  --sizes=N,N...     container sizes (default: 100000,1000000)\n"
+  "  --format=FORMAT    table, csv or json (default: table)\n";
+
+struct Subject
+{
+  std::string container;
+  std::string element;
+  std::function<aisdi::bench::Footprint(size_type)> measure;
+};
+
+template <typename Container>
+void addSubject(aisdi::Vector<Subject>& subjects, const std::string& container, const std::string& element)
+{
+  subjects.append({ container, element, [=](size_type size)
+  {
+    return aisdi::bench::measureFootprint<Container>(container, element, size);
+  } });
+}
+
+template <typename Type>
+void addContainers(aisdi::Vector<Subject>& subjects, const std::string& element)
+{
+  using namespace aisdi::bench;
+  addSubject<aisdi::Vector<Type>>(subjects, "Vector", element);
+  addSubject<StdVectorAdapter<Type>>(subjects, "std::vector", element);
+  addSubject<StdDequeAdapter<Type>>(subjects, "std::deque", element);
+  addSubject<aisdi::LinkedList<Type>>(subjects, "LinkedList", element);
+  addSubject<StdListAdapter<Type>>(subjects, "std::list", element);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  using namespace aisdi::bench;
+  aisdi::Vector<std::string> filters;
+  aisdi::Vector<size_type> sizes = { 100000, 1000000 };
+  std::string format = "table";
+  try
+  {
+    for(int i = 1; i < argc; i++)
+    {
+      const std::string argument = argv[i];
+      const CommandLineOption option(argument);
+      if(option.name == "--filter")
+        filters.append(option.value);
+      else if(option.name == "--sizes")
+        sizes = detail::parseCountList(argument, option.value);
+      else if(option.name == "--format" and detail::isFormat(option.value))
+        format = option.value;
+      else
+        throw std::invalid_argument("Unknown option " + argument);
+    }
+  }
+  catch(const std::invalid_argument& error)
+  {
+    std::cerr<<error.what()<<std::endl<<footprintUsage;
+    return 2;
+  }
+
+  aisdi::Vector<Subject> subjects;
+  addContainers<int>(subjects, "int");
+  addContainers<std::string>(subjects, "string");
+  addContainers<TrivialPayload<64>>(subjects, "pod64");
+
+  aisdi::Vector<Footprint> footprints;
+  for(const Subject& subject : subjects)
+    for(size_type size : sizes)
+    {
+      const std::string name = subject.container + "/" + subject.element + "/" + std::to_string(size);
+      if(isSelected(filters, name))
+        footprints.append(subject.measure(size));
+    }
+
+  if(format == "csv")
+    writeFootprintCsv(std::cout, footprints);
+  else if(format == "json")
+    writeFootprintJson(std::cout, footprints);
+  else
+    writeFootprintTable(std::cout, footprints);
+  return 0;
+}
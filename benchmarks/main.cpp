@@ -0,0 +1,26 @@
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "BenchmarkMain.h"
+#include "LinearBenchmarks.h"
+
+namespace
+{
+
+void registerBenchmarks(aisdi::bench::Registry& registry)
+{
+  using namespace aisdi::bench;
+  registerLinearBenchmarks<aisdi::Vector<int>>(registry, "Vector", "int");
+  registerLinearBenchmarks<aisdi::Vector<std::string>>(registry, "Vector", "string");
+  registerLinearBenchmarks<aisdi::LinkedList<int>>(registry, "LinkedList", "int");
+  registerLinearBenchmarks<aisdi::LinkedList<std::string>>(registry, "LinkedList", "string");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  return aisdi::bench::runBenchmarkMain(argc, argv, registerBenchmarks);
+}
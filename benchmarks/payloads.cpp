@@ -0,0 +1,43 @@
+// The linear benchmarks of Vector and LinkedList over payloads of 4 to 1024
+// bytes, held in place or on the heap, to see at which element size and
+// kind shifting a Vector stops beating relinking a LinkedList.
+
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "BenchmarkMain.h"
+#include "LinearBenchmarks.h"
+#include "Payloads.h"
+
+namespace
+{
+
+// pod<Bytes> in place, own<Bytes> on the heap
+template <std::size_t Bytes>
+void registerPayloads(aisdi::bench::Registry& registry)
+{
+  using namespace aisdi::bench;
+  const std::string size = std::to_string(Bytes);
+  registerLinearBenchmarks<aisdi::Vector<TrivialPayload<Bytes>>>(registry, "Vector", "pod" + size);
+  registerLinearBenchmarks<aisdi::LinkedList<TrivialPayload<Bytes>>>(registry, "LinkedList", "pod" + size);
+  registerLinearBenchmarks<aisdi::Vector<OwningPayload<Bytes>>>(registry, "Vector", "own" + size);
+  registerLinearBenchmarks<aisdi::LinkedList<OwningPayload<Bytes>>>(registry, "LinkedList", "own" + size);
+}
+
+void registerBenchmarks(aisdi::bench::Registry& registry)
+{
+  registerPayloads<4>(registry);
+  registerPayloads<16>(registry);
+  registerPayloads<64>(registry);
+  registerPayloads<256>(registry);
+  registerPayloads<1024>(registry);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  return aisdi::bench::runBenchmarkMain(argc, argv, registerBenchmarks);
+}
@@ -0,0 +1,56 @@
+// Traverses Vector and LinkedList at a working set per memory tier, sized
+// from the caches sysfs reports, to show where each falls out of a cache.
+// Sizes in the results are working sets in bytes.
+
+#include <iostream>
+#include <string>
+
+#include "Vector.h"
+
+#include "BenchmarkMain.h"
+#include "MemorySweep.h"
+
+namespace
+{
+
+aisdi::Vector<aisdi::bench::ScatterCheck> scatterChecks;
+
+void registerBenchmarks(aisdi::bench::Registry& registry)
+{
+  aisdi::bench::registerMemorySweep<int>(registry, "int", &scatterChecks);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  using namespace aisdi::bench;
+  aisdi::Vector<CacheLevel> caches = detectDataCaches();
+  if(caches.isEmpty())
+  {
+    std::cerr<<"No caches in sysfs, assuming 32 KiB, 1 MiB and 8 MiB"<<std::endl;
+    for(const CacheLevel& cache : fallbackCaches)
+      caches.append(cache);
+  }
+
+  std::string sizes = "--sizes=";
+  for(const MemoryTier& tier : memoryTiers(caches))
+  {
+    std::cerr<<tier.name<<": "<<tier.workingSetBytes<<" B working set"<<std::endl;
+    sizes += std::to_string(tier.workingSetBytes) + ",";
+  }
+  sizes.erase(sizes.size() - 1);
+
+  // a --sizes given on the command line comes later and wins
+  aisdi::Vector<char*> arguments = { argv[0], &sizes[0] };
+  for(int i = 1; i < argc; i++)
+    arguments.append(argv[i]);
+  const int status = runBenchmarkMain((int)arguments.getSize(), arguments.data(), registerBenchmarks);
+
+  // on stderr like the tiers, so machine formats on stdout stay parseable
+  for(const ScatterCheck& check : scatterChecks)
+    std::cerr<<"shuffled-node at "<<check.workingSetBytes<<" B: "<<check.adjacentFraction * 100
+             <<"% of neighbouring nodes adjacent"<<(check.adjacentFraction > 0.1 ? " - not scattered, "
+                "malloc didn't reuse the freed blocks in order" : "")<<std::endl;
+  return status;
+}
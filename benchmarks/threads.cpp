@@ -0,0 +1,199 @@
+// Runs Vector and LinkedList churn on many threads at once, each on its own
+// container or all on a shared one, and reports how the aggregate
+// throughput scales: allocator contention and false sharing show up as
+// speedups below the thread count.
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "Benchmark.h"
+#include "ThreadedBenchmark.h"
+
+namespace
+{
+
+using aisdi::bench::size_type;
+
+const char* const threadsUsage =
+  "options:\n"
+  "  --filter=PATTERN   mode/container/element/threads, * matches anything; modes are\n"
+  "                     own, packed, padded and shared (default: all)\n"
+  "  --threads=N,N...   thread counts (default: 1, 2, 4, ... up to twice the CPUs)\n"
+  "  --size=N           elements each thread appends and pops per round (default: 1000)\n"
+  "  --operations=N     operations per thread and sample (default: 1000000)\n"
+  "  --repetitions=N    samples per run; the median counts (default: 5)\n"
+  "  --format=FORMAT    table, csv or json (default: table)\n"
+  "  --no-pin           leave the threads where the scheduler puts them\n";
+
+struct Subject
+{
+  std::string container;
+  std::string element;
+  std::function<aisdi::bench::ThreadedRun(aisdi::bench::ThreadingMode, size_type, size_type, size_type,
+                                          const aisdi::Vector<int>&)> run;
+};
+
+template <typename Container>
+void addSubject(aisdi::Vector<Subject>& subjects, const std::string& container, const std::string& element)
+{
+  subjects.append({ container, element, aisdi::bench::runThreaded<Container> });
+}
+
+struct Scaling
+{
+  std::string name;
+  std::string mode;
+  std::string container;
+  std::string element;
+  size_type threads;
+  double operationsPerSecond;
+  bool pinned;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  using namespace aisdi::bench;
+  const aisdi::Vector<int> cpus = allowedCpus();
+  aisdi::Vector<std::string> filters;
+  aisdi::Vector<size_type> threadCounts;
+  for(size_type threads = 1; threads < 2 * cpus.getSize() or threads <= 4; threads *= 2)
+    threadCounts.append(threads);
+  size_type size = 1000;
+  size_type operations = 1000000;
+  size_type repetitions = 5;
+  std::string format = "table";
+  bool pin = true;
+  try
+  {
+    for(int i = 1; i < argc; i++)
+    {
+      const std::string argument = argv[i];
+      const CommandLineOption option(argument);
+      const std::string& name = option.name;
+      const std::string& value = option.value;
+      if(name == "--filter")
+        filters.append(value);
+      else if(name == "--threads")
+        threadCounts = detail::parseCountList(argument, value);
+      else if(name == "--size")
+        size = std::max<size_type>(1, detail::parseCount(argument, value));
+      else if(name == "--operations")
+        operations = detail::parseCount(argument, value);
+      else if(name == "--repetitions")
+        repetitions = std::max<size_type>(1, detail::parseCount(argument, value));
+      else if(name == "--format" and detail::isFormat(value))
+        format = value;
+      else if(argument == "--no-pin")
+        pin = false;
+      else
+        throw std::invalid_argument("Unknown option " + argument);
+    }
+  }
+  catch(const std::invalid_argument& error)
+  {
+    std::cerr<<error.what()<<std::endl<<threadsUsage;
+    return 2;
+  }
+
+  aisdi::Vector<Subject> subjects;
+  addSubject<aisdi::Vector<int>>(subjects, "Vector", "int");
+  addSubject<aisdi::Vector<std::string>>(subjects, "Vector", "string");
+  addSubject<aisdi::LinkedList<int>>(subjects, "LinkedList", "int");
+  addSubject<aisdi::LinkedList<std::string>>(subjects, "LinkedList", "string");
+
+  // an append and a pop per element and round
+  const size_type rounds = std::max<size_type>(1, operations / (2 * size));
+  const aisdi::Vector<int> noCpus;
+  aisdi::Vector<Scaling> results;
+  for(size_type mode = 0; mode != threadingModeCount; mode++)
+    for(const Subject& subject : subjects)
+      for(size_type threads : threadCounts)
+      {
+        Scaling scaling;
+        scaling.mode = threadingModeName(mode);
+        scaling.container = subject.container;
+        scaling.element = subject.element;
+        scaling.threads = threads;
+        scaling.name = scaling.mode + "/" + subject.container + "/" + subject.element + "/" + std::to_string(threads);
+        if(!isSelected(filters, scaling.name))
+          continue;
+        aisdi::Vector<double> samples;
+        scaling.pinned = true;
+        for(size_type repetition = 0; repetition != repetitions; repetition++)
+        {
+          const ThreadedRun run = subject.run((ThreadingMode)mode, threads, size, rounds, pin ? cpus : noCpus);
+          samples.append(run.nanoseconds);
+          scaling.pinned = scaling.pinned and run.pinned;
+        }
+        scaling.operationsPerSecond = threads * rounds * 2 * size / summarize(samples).median * 1e9;
+        results.append(scaling);
+      }
+
+  // the run of the fewest threads of the same mode, container and element,
+  // which speedups are over; it needn't have a single thread
+  auto referenceOf = [&](const Scaling& scaling) -> const Scaling&
+  {
+    const Scaling* fewest = &scaling;
+    for(const Scaling& other : results)
+      if(other.mode == scaling.mode and other.container == scaling.container and
+         other.element == scaling.element and other.threads < fewest->threads)
+        fewest = &other;
+    return *fewest;
+  };
+  auto speedupOf = [&](const Scaling& scaling)
+  {
+    return scaling.operationsPerSecond / referenceOf(scaling).operationsPerSecond;
+  };
+  // the speedup against the one linear scaling from the reference would give
+  auto efficiencyOf = [&](const Scaling& scaling)
+  {
+    return speedupOf(scaling) * referenceOf(scaling).threads / scaling.threads;
+  };
+
+  if(format == "csv")
+  {
+    std::cout<<"mode,container,element,threads,operations_per_second,speedup,efficiency,pinned"<<std::endl;
+    for(const Scaling& scaling : results)
+      std::cout<<scaling.mode<<','<<scaling.container<<','<<scaling.element<<','<<scaling.threads<<','
+               <<scaling.operationsPerSecond<<','<<speedupOf(scaling)<<','<<efficiencyOf(scaling)<<','
+               <<scaling.pinned<<std::endl;
+    return 0;
+  }
+  if(format == "json")
+  {
+    std::cout<<"["<<std::endl;
+    size_type written = 0;
+    for(const Scaling& scaling : results)
+      std::cout<<"  {\"mode\": "<<jsonString(scaling.mode)<<", \"container\": "<<jsonString(scaling.container)
+               <<", \"element\": "<<jsonString(scaling.element)<<", \"threads\": "<<scaling.threads
+               <<", \"operations_per_second\": "<<scaling.operationsPerSecond<<", \"speedup\": "<<speedupOf(scaling)
+               <<", \"efficiency\": "<<efficiencyOf(scaling)<<", \"pinned\": "<<(scaling.pinned ? "true" : "false")<<"}"
+               <<(++written != results.getSize() ? "," : "")<<std::endl;
+    std::cout<<"]"<<std::endl;
+    return 0;
+  }
+  std::cout<<cpus.getSize()<<" CPUs; "<<size<<" elements per round, "<<rounds * 2 * size
+           <<" operations per thread"<<std::endl;
+  std::cout<<std::left<<std::setw(8)<<"mode"<<std::setw(12)<<"container"<<std::setw(10)<<"element"
+           <<std::right<<std::setw(8)<<"threads"<<std::setw(14)<<"[M ops/s]"<<std::setw(10)<<"speedup"
+           <<std::setw(12)<<"efficiency"<<std::endl;
+  for(const Scaling& scaling : results)
+  {
+    std::cout<<std::left<<std::setw(8)<<scaling.mode<<std::setw(12)<<scaling.container<<std::setw(10)
+             <<scaling.element<<std::right<<std::setw(8)<<scaling.threads<<std::fixed<<std::setprecision(2)
+             <<std::setw(14)<<scaling.operationsPerSecond / 1e6<<std::setw(10)<<speedupOf(scaling)
+             <<std::setw(11)<<efficiencyOf(scaling) * 100<<"%"<<(scaling.pinned ? "" : "  (not pinned)")
+             <<std::endl;
+  }
+  if(threadCounts.getSize() != 0 and *(threadCounts.end() - 1) > cpus.getSize())
+    std::cout<<"(more threads than CPUs share them, so efficiency there is bounded by the CPU count)"<<std::endl;
+  return 0;
+}
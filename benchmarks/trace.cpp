@@ -0,0 +1,210 @@
+// Records container traffic to trace files and replays them against every
+// container, for workloads a synthetic loop doesn't capture.
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "LinkedList.h"
+#include "Vector.h"
+
+#include "Benchmark.h"
+#include "StdAdapters.h"
+#include "Trace.h"
+
+namespace
+{
+
+using aisdi::bench::size_type;
+
+const char* const traceUsage =
+  "usage:\n"
+  "  aisdiTrace generate FILE [--operations=N] [--size=N] [--seed=N]\n"
+  "      record a random mix of operations on a Vector<int> of about size elements\n"
+  "      (defaults: 1000000 operations, 10000 elements, seed 1)\n"
+  "  aisdiTrace replay FILE [--filter=PATTERN]...\n"
+  "      replay it on Vector, LinkedList, std::vector, std::deque and std::list\n"
+  "      of int and string; PATTERN is container/element, * matches anything,\n"
+  "      repeat for alternatives (default: all)\n";
+
+const char* const replayedContainers[] = { "Vector", "LinkedList", "std::vector", "std::deque", "std::list" };
+const char* const replayedElements[] = { "int", "string" };
+
+// Mostly appends, pops and edits anywhere, now and then a short range erase
+// or a scan. Adds slightly outweigh removals, so the container grows to
+// size and stays there, adds turning into removals while it is full.
+void generate(const std::string& path, std::uint64_t operations, std::uint64_t size, std::uint64_t seed)
+{
+  using namespace aisdi::bench;
+  TraceWriter trace(path);
+  TracingContainer<aisdi::Vector<int>> items(trace);
+  std::mt19937_64 random(seed);
+  std::discrete_distribution<int> pick({ 36, 5, 15, 12, 1, 5, 20, 1 });
+  int nextValue = 0;
+  for(std::uint64_t done = 0; done != operations; done++)
+  {
+    int operation = pick(random);
+    const size_type count = items.getSize();
+    if(count == 0)
+      operation = traceAppend;
+    else if(count >= size and operation <= traceInsert)
+      operation = tracePopLast;
+    switch(operation)
+    {
+      case traceAppend:
+        items.append(nextValue++);
+        break;
+      case tracePrepend:
+        items.prepend(nextValue++);
+        break;
+      case traceInsert:
+        items.insert(items.cbegin() + random() % (count + 1), nextValue++);
+        break;
+      case traceErase:
+        items.erase(items.cbegin() + random() % count);
+        break;
+      case traceEraseRange:
+      {
+        const size_type first = random() % count;
+        const size_type length = random() % std::min<size_type>(count - first, 16) + 1;
+        items.erase(items.cbegin() + first, items.cbegin() + (first + length));
+        break;
+      }
+      case tracePopFirst:
+        items.popFirst();
+        break;
+      case tracePopLast:
+        items.popLast();
+        break;
+      default:
+        items.scan([](int item) { doNotOptimize(item); });
+        break;
+    }
+  }
+  trace.close();
+  std::cout<<"Recorded "<<trace.getCount()<<" operations to "<<path<<std::endl;
+}
+
+template <typename Container>
+void replay(const std::string& path, const std::string& container, const std::string& element)
+{
+  using namespace aisdi::bench;
+  TraceReader trace(path);
+  Container items;
+  const ReplayResult result = replayTrace(trace, items);
+
+  std::cout<<container<<"<"<<element<<">: "<<result.operations<<" operations in "
+           <<std::fixed<<std::setprecision(2)<<result.nanoseconds / 1e6<<" ms, "
+           <<result.operationsPerSecond() / 1e6<<" M operations/s"<<std::endl;
+  std::cout<<"  "<<std::left<<std::setw(14)<<"operation"<<std::right<<std::setw(12)<<"count"
+           <<std::setw(12)<<"p50 [ns]"<<std::setw(12)<<"p99 [ns]"<<std::setw(12)<<"p99.9 [ns]"
+           <<std::setw(14)<<"max [ns]"<<std::endl;
+  for(size_type operation = 0; operation != traceOperationCount; operation++)
+  {
+    const LatencyHistogram& latencies = result.getLatencies(operation);
+    if(latencies.getCount() == 0)
+      continue;
+    std::cout<<"  "<<std::left<<std::setw(14)<<traceOperationName(operation)<<std::right
+             <<std::setw(12)<<result.counts[operation]
+             <<std::setw(12)<<latencyNanoseconds(latencies.valueAtPercentile(50))
+             <<std::setw(12)<<latencyNanoseconds(latencies.valueAtPercentile(99))
+             <<std::setw(12)<<latencyNanoseconds(latencies.valueAtPercentile(99.9))
+             <<std::setw(14)<<latencyNanoseconds(latencies.getMax())<<std::endl;
+  }
+}
+
+template <typename Type>
+void replayOn(const std::string& path, const std::string& container, const std::string& element)
+{
+  using namespace aisdi::bench;
+  if(container == "Vector")
+    replay<aisdi::Vector<Type>>(path, container, element);
+  else if(container == "LinkedList")
+    replay<aisdi::LinkedList<Type>>(path, container, element);
+  else if(container == "std::vector")
+    replay<StdVectorAdapter<Type>>(path, container, element);
+  else if(container == "std::deque")
+    replay<StdDequeAdapter<Type>>(path, container, element);
+  else
+    replay<StdListAdapter<Type>>(path, container, element);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if(argc < 3)
+  {
+    std::cerr<<traceUsage;
+    return 2;
+  }
+  const std::string mode = argv[1];
+  const std::string path = argv[2];
+  std::uint64_t operations = 1000000;
+  std::uint64_t size = 10000;
+  std::uint64_t seed = 1;
+  aisdi::Vector<std::string> filters;
+  try
+  {
+    for(int i = 3; i < argc; i++)
+    {
+      const std::string argument = argv[i];
+      const aisdi::bench::CommandLineOption option(argument);
+      if(mode == "generate" and option.name == "--operations")
+        operations = aisdi::bench::detail::parseCount(argument, option.value);
+      else if(mode == "generate" and option.name == "--size")
+        size = std::max<std::uint64_t>(1, aisdi::bench::detail::parseCount(argument, option.value));
+      else if(mode == "generate" and option.name == "--seed")
+        seed = aisdi::bench::detail::parseCount(argument, option.value);
+      else if(mode == "replay" and option.name == "--filter")
+        filters.append(option.value);
+      else
+        throw std::invalid_argument("Unknown option " + argument);
+    }
+  }
+  catch(const std::invalid_argument& error)
+  {
+    std::cerr<<error.what()<<std::endl<<traceUsage;
+    return 2;
+  }
+
+  try
+  {
+    if(mode == "generate")
+      generate(path, operations, size, seed);
+    else if(mode == "replay")
+    {
+      bool replayed = false;
+      for(const std::string element : replayedElements)
+        for(const std::string container : replayedContainers)
+          if(aisdi::bench::isSelected(filters, container + "/" + element))
+          {
+            if(element == "int")
+              replayOn<int>(path, container, element);
+            else
+              replayOn<std::string>(path, container, element);
+            replayed = true;
+          }
+      if(!replayed)
+      {
+        std::cerr<<"No container matches the filters"<<std::endl<<traceUsage;
+        return 2;
+      }
+    }
+    else
+    {
+      std::cerr<<"Unknown mode "<<mode<<std::endl<<traceUsage;
+      return 2;
+    }
+  }
+  catch(const std::runtime_error& error)
+  {
+    std::cerr<<error.what()<<std::endl;
+    return 1;
+  }
+  return 0;
+}
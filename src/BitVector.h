@@ -0,0 +1,533 @@
+#ifndef AISDI_LINEAR_BITVECTOR_H
+#define AISDI_LINEAR_BITVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "PackedVector.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// Branch-free popcount from shifts, masks and adds only. In a loop over
+// words the compiler vectorises it with plain SSE2/NEON - no intrinsics and no
+// dependence on a hardware popcnt instruction being enabled.
+inline unsigned popcount64(std::uint64_t word)
+{
+  word = word - ((word >> 1) & 0x5555555555555555ull);
+  word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return (unsigned)((word * 0x0101010101010101ull) >> 56);
+}
+
+inline std::size_t popcountWords(const std::uint64_t* words, std::size_t count)
+{
+  std::size_t total = 0;
+  for(std::size_t i = 0; i != count; i++)
+    total += popcount64(words[i]);
+  return total;
+}
+
+// Position of the rank-th (0-based) set bit of word, which has more than rank.
+inline unsigned selectInWord(std::uint64_t word, unsigned rank)
+{
+  for(unsigned i = 0; i != rank; i++)
+    word &= word - 1;
+  return (unsigned)__builtin_ctzll(word);
+}
+
+}
+
+// Vector of bits stored 64 to a word. Besides per-bit access (through a proxy
+// reference) it works a word at a time: and/or/xor/flip of whole vectors,
+// counting and finding set bits. rank() and select() scan the words unless
+// buildRankIndex() was called since the last modification; the index keeps a
+// running count per 512 bits, so they then cost one lookup and a short scan.
+// Bits past getSize() in the last word are always zero.
+class BitVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = bool;
+
+  class Reference;
+  class ConstIterator;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  static const size_type wordsPerBlock = 8;
+
+private:
+  size_type vectorSize;
+  size_type reservedWords;
+  std::uint64_t* words;
+  // set bits before each block of wordsPerBlock words, plus the total
+  Vector<size_type> blockRanks;
+  bool rankIndexValid;
+
+  static size_type wordsFor(size_type bits)
+  {
+    return (bits + 63) / 64;
+  }
+
+  size_type usedWords() const
+  {
+    return wordsFor(vectorSize);
+  }
+
+  void reallocate(size_type needed)
+  {
+    size_type newReserved = reservedWords != 0 ? reservedWords * 2 : 4;
+    while(newReserved < needed)
+      newReserved *= 2;
+    auto newWords = new std::uint64_t[newReserved]();
+    for(size_type i = 0; i != reservedWords; i++)
+      newWords[i] = words[i];
+    delete [] words;
+    words = newWords;
+    reservedWords = newReserved;
+  }
+
+  void clearTail()
+  {
+    if(vectorSize % 64 != 0)
+      words[vectorSize / 64] &= detail::lowBitsMask(vectorSize % 64);
+  }
+
+  void checkSameSize(const BitVector& other) const
+  {
+    if(other.vectorSize != vectorSize)
+      throw std::invalid_argument("Bit vectors differ in size");
+  }
+
+  size_type rankFromWord(size_type word, size_type index) const
+  {
+    size_type count = 0;
+    for(; word != index / 64; word++)
+      count += detail::popcount64(words[word]);
+    if(index % 64 != 0)
+      count += detail::popcount64(words[word] & detail::lowBitsMask(index % 64));
+    return count;
+  }
+
+public:
+  BitVector()
+    : vectorSize(0), reservedWords(0), words(nullptr), rankIndexValid(false)
+  {}
+
+  // count bits, all equal to value
+  explicit BitVector(size_type count, bool value = false)
+    : BitVector()
+  {
+    if(count == 0)
+      return;
+    reallocate(wordsFor(count));
+    vectorSize = count;
+    if(value)
+    {
+      for(size_type i = 0; i != usedWords(); i++)
+        words[i] = ~std::uint64_t(0);
+      clearTail();
+    }
+  }
+
+  BitVector(std::initializer_list<bool> l)
+    : BitVector()
+  {
+    for(auto i = l.begin(); i != l.end(); i++)
+      append(*i);
+  }
+
+  BitVector(const BitVector& other)
+    : vectorSize(other.vectorSize), reservedWords(other.reservedWords),
+      words(other.reservedWords != 0 ? new std::uint64_t[other.reservedWords] : nullptr),
+      blockRanks(other.blockRanks), rankIndexValid(other.rankIndexValid)
+  {
+    for(size_type i = 0; i != reservedWords; i++)
+      words[i] = other.words[i];
+  }
+
+  BitVector(BitVector&& other)
+    : vectorSize(other.vectorSize), reservedWords(other.reservedWords), words(other.words),
+      blockRanks(std::move(other.blockRanks)), rankIndexValid(other.rankIndexValid)
+  {
+    other.vectorSize = 0;
+    other.reservedWords = 0;
+    other.words = nullptr;
+    other.rankIndexValid = false;
+  }
+
+  ~BitVector()
+  {
+    delete [] words;
+  }
+
+  BitVector& operator=(BitVector other)
+  {
+    std::swap(vectorSize, other.vectorSize);
+    std::swap(reservedWords, other.reservedWords);
+    std::swap(words, other.words);
+    std::swap(blockRanks, other.blockRanks);
+    std::swap(rankIndexValid, other.rankIndexValid);
+    return *this;
+  }
+
+  bool isEmpty() const
+  {
+    return vectorSize == 0;
+  }
+
+  size_type getSize() const
+  {
+    return vectorSize;
+  }
+
+  // Heap bytes held by the bits and the rank index.
+  size_type getBytes() const
+  {
+    return reservedWords * sizeof(std::uint64_t) + blockRanks.getCapacity() * sizeof(size_type);
+  }
+
+  // The packed words, least significant bit first; getWordCount() of them.
+  const std::uint64_t* getWords() const
+  {
+    return words;
+  }
+
+  size_type getWordCount() const
+  {
+    return usedWords();
+  }
+
+  void append(bool item)
+  {
+    if(wordsFor(vectorSize + 1) > reservedWords)
+      reallocate(wordsFor(vectorSize + 1));
+    if(item)
+      words[vectorSize / 64] |= std::uint64_t(1) << (vectorSize % 64);
+    vectorSize++;
+    rankIndexValid = false;
+  }
+
+  bool popLast()
+  {
+    if(isEmpty())
+      throw std::out_of_range("Can't delete last element in empty vector");
+    const bool result = at(vectorSize - 1);
+    vectorSize--;
+    words[vectorSize / 64] &= ~(std::uint64_t(1) << (vectorSize % 64));
+    rankIndexValid = false;
+    return result;
+  }
+
+  bool operator[](size_type index) const
+  {
+    return ((words[index / 64] >> (index % 64)) & 1) != 0;
+  }
+
+  Reference operator[](size_type index);
+
+  bool at(size_type index) const
+  {
+    if(index >= vectorSize)
+      throw std::out_of_range("Index out of bit vector");
+    return (*this)[index];
+  }
+
+  void set(size_type index, bool item)
+  {
+    if(index >= vectorSize)
+      throw std::out_of_range("Index out of bit vector");
+    const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+    words[index / 64] = item ? words[index / 64] | bit : words[index / 64] & ~bit;
+    rankIndexValid = false;
+  }
+
+  BitVector& operator&=(const BitVector& other)
+  {
+    checkSameSize(other);
+    for(size_type i = 0; i != usedWords(); i++)
+      words[i] &= other.words[i];
+    rankIndexValid = false;
+    return *this;
+  }
+
+  BitVector& operator|=(const BitVector& other)
+  {
+    checkSameSize(other);
+    for(size_type i = 0; i != usedWords(); i++)
+      words[i] |= other.words[i];
+    rankIndexValid = false;
+    return *this;
+  }
+
+  BitVector& operator^=(const BitVector& other)
+  {
+    checkSameSize(other);
+    for(size_type i = 0; i != usedWords(); i++)
+      words[i] ^= other.words[i];
+    rankIndexValid = false;
+    return *this;
+  }
+
+  // Inverts every bit.
+  BitVector& flip()
+  {
+    for(size_type i = 0; i != usedWords(); i++)
+      words[i] = ~words[i];
+    clearTail();
+    rankIndexValid = false;
+    return *this;
+  }
+
+  BitVector operator~() const
+  {
+    BitVector result(*this);
+    result.flip();
+    return result;
+  }
+
+  // Number of set bits.
+  size_type count() const
+  {
+    return detail::popcountWords(words, usedWords());
+  }
+
+  // Index of the first set bit, or getSize() when there is none.
+  size_type findFirstSet() const
+  {
+    for(size_type i = 0; i != usedWords(); i++)
+      if(words[i] != 0)
+        return i * 64 + __builtin_ctzll(words[i]);
+    return vectorSize;
+  }
+
+  // Index of the first set bit after index, or getSize() when there is none.
+  size_type findNextSet(size_type index) const
+  {
+    if(index + 1 >= vectorSize)
+      return vectorSize;
+    index++;
+    size_type word = index / 64;
+    std::uint64_t bits = words[word] & ~detail::lowBitsMask(index % 64);
+    while(bits == 0)
+    {
+      if(++word == usedWords())
+        return vectorSize;
+      bits = words[word];
+    }
+    return word * 64 + __builtin_ctzll(bits);
+  }
+
+  void buildRankIndex()
+  {
+    const size_type blocks = (usedWords() + wordsPerBlock - 1) / wordsPerBlock;
+    Vector<size_type> ranks;
+    ranks.reserve(blocks + 1);
+    size_type total = 0;
+    for(size_type block = 0; block != blocks; block++)
+    {
+      ranks.append(total);
+      const size_type first = block * wordsPerBlock;
+      const size_type last = first + wordsPerBlock < usedWords() ? first + wordsPerBlock : usedWords();
+      total += detail::popcountWords(words + first, last - first);
+    }
+    ranks.append(total);
+    blockRanks = std::move(ranks);
+    rankIndexValid = true;
+  }
+
+  // Number of set bits before index; index may equal getSize().
+  size_type rank(size_type index) const
+  {
+    if(index > vectorSize)
+      throw std::out_of_range("Index out of bit vector");
+    if(!rankIndexValid)
+      return rankFromWord(0, index);
+    const size_type block = index / 64 / wordsPerBlock;
+    if(block == blockRanks.getSize() - 1)
+      return blockRanks.data()[block];
+    return blockRanks.data()[block] + rankFromWord(block * wordsPerBlock, index);
+  }
+
+  // Index of the set bit with rank rank (0-based), or getSize() when there
+  // are not that many set bits.
+  size_type select(size_type rank) const
+  {
+    size_type word = 0;
+    size_type remaining = rank;
+    if(rankIndexValid)
+    {
+      const size_type* ranks = blockRanks.data();
+      const size_type blocks = blockRanks.getSize() - 1;
+      if(rank >= ranks[blocks])
+        return vectorSize;
+      // last block whose running count is <= rank
+      size_type low = 0;
+      size_type high = blocks;
+      while(high - low > 1)
+      {
+        const size_type middle = (low + high) / 2;
+        if(ranks[middle] <= rank)
+          low = middle;
+        else
+          high = middle;
+      }
+      word = low * wordsPerBlock;
+      remaining = rank - ranks[low];
+    }
+    for(; word != usedWords(); word++)
+    {
+      const unsigned inWord = detail::popcount64(words[word]);
+      if(remaining < inWord)
+        return word * 64 + detail::selectInWord(words[word], (unsigned)remaining);
+      remaining -= inWord;
+    }
+    return vectorSize;
+  }
+
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  const_iterator begin() const;
+  const_iterator end() const;
+};
+
+// Stands in for bool& - a single bit has no address.
+class BitVector::Reference
+{
+  BitVector* pointerToVector;
+  size_type index;
+
+public:
+  Reference(BitVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  operator bool() const
+  {
+    return (*static_cast<const BitVector*>(pointerToVector))[index];
+  }
+
+  Reference& operator=(bool item)
+  {
+    pointerToVector->set(index, item);
+    return *this;
+  }
+
+  Reference& operator=(const Reference& other)
+  {
+    return *this = static_cast<bool>(other);
+  }
+
+  Reference& flip()
+  {
+    return *this = !static_cast<bool>(*this);
+  }
+};
+
+inline BitVector::Reference BitVector::operator[](size_type index)
+{
+  return Reference(this, index);
+}
+
+// Yields values rather than references, like PackedVector's iterator.
+class BitVector::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = bool;
+  using difference_type = BitVector::difference_type;
+  using pointer = const bool*;
+  using reference = bool;
+
+  const BitVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0)
+  {}
+
+  ConstIterator(const BitVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or pointerToVector->vectorSize <= index)
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    return (*pointerToVector)[index];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index == pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(index == 0)
+      throw std::out_of_range("Can't decrease iterator");
+    index--;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result(*this);
+    --(*this);
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+inline BitVector::const_iterator BitVector::cbegin() const
+{
+  return ConstIterator(this, 0);
+}
+
+inline BitVector::const_iterator BitVector::cend() const
+{
+  return ConstIterator(this, vectorSize);
+}
+
+inline BitVector::const_iterator BitVector::begin() const
+{
+  return cbegin();
+}
+
+inline BitVector::const_iterator BitVector::end() const
+{
+  return cend();
+}
+
+}
+
+#endif // AISDI_LINEAR_BITVECTOR_H
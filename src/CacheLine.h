@@ -0,0 +1,32 @@
+#ifndef AISDI_LINEAR_CACHELINE_H
+#define AISDI_LINEAR_CACHELINE_H
+
+#include <cstddef>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+const std::size_t cacheLineSize = 64;
+
+// Value padded to a multiple of the cache line size, so that neighbouring
+// members written by different threads don't share a line. Padding instead of
+// alignas keeps heap allocation of the owner valid before C++17's aligned new.
+template <typename Type>
+struct CacheLinePadded
+{
+  Type value;
+  char padding[cacheLineSize - sizeof(Type) % cacheLineSize];
+
+  CacheLinePadded()
+    : value()
+  {}
+};
+
+}
+
+}
+
+#endif // AISDI_LINEAR_CACHELINE_H
@@ -0,0 +1,179 @@
+#ifndef AISDI_LINEAR_CAPACITYHINTS_H
+#define AISDI_LINEAR_CAPACITYHINTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ContainerStats.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// How big the containers made at one allocation site tend to end up. A
+// bigger final size raises the estimate at once; smaller ones lower it by an
+// eighth of the difference, so an occasional small container doesn't bring
+// the reallocations back.
+class CapacityHintSite
+{
+public:
+  using size_type = std::size_t;
+
+private:
+  std::atomic<size_type> estimate;
+  std::atomic<size_type> samples;
+
+public:
+  CapacityHintSite()
+    : estimate(0), samples(0)
+  {}
+
+  size_type getHint() const
+  {
+    return estimate.load(std::memory_order_relaxed);
+  }
+
+  size_type getSamples() const
+  {
+    return samples.load(std::memory_order_relaxed);
+  }
+
+  void record(size_type finalSize)
+  {
+    size_type current = estimate.load(std::memory_order_relaxed);
+    size_type next;
+    do
+      next = finalSize >= current ? finalSize : current - (current - finalSize) / 8;
+    while(next != current and
+          !estimate.compare_exchange_weak(current, next, std::memory_order_relaxed));
+    samples.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Used when loading a saved table.
+  void restore(size_type hint, size_type sampleCount)
+  {
+    estimate.store(hint, std::memory_order_relaxed);
+    samples.store(sampleCount, std::memory_order_relaxed);
+  }
+};
+
+// Hint table keyed by allocation site name. Sites are never removed, so the
+// reference site() returns stays valid for the whole program.
+class CapacityHints
+{
+  mutable std::mutex mutex;
+  std::map<std::string, CapacityHintSite> sites;
+
+  CapacityHints()
+  {}
+
+public:
+  using size_type = std::size_t;
+
+  static CapacityHints& instance()
+  {
+    static CapacityHints hints;
+    return hints;
+  }
+
+  CapacityHintSite& site(const std::string& name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sites[name];
+  }
+
+  // One "hint samples name" line per site. Throws std::runtime_error when
+  // the file can't be written.
+  void save(const std::string& path) const
+  {
+    std::ofstream out(path.c_str(), std::ios::trunc);
+    if(!out)
+      throw std::runtime_error("Can't write capacity hints to " + path);
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto i = sites.begin(); i != sites.end(); i++)
+      out<<i->second.getHint()<<' '<<i->second.getSamples()<<' '<<i->first<<'\n';
+    if(!out.flush())
+      throw std::runtime_error("Can't write capacity hints to " + path);
+  }
+
+  // Replaces the hints of the sites in the file and keeps the others.
+  // Throws std::runtime_error when the file can't be read or is malformed.
+  void load(const std::string& path)
+  {
+    std::ifstream in(path.c_str());
+    if(!in)
+      throw std::runtime_error("Can't read capacity hints from " + path);
+    size_type hint;
+    size_type samples;
+    std::string name;
+    while(in>>hint>>samples)
+    {
+      in.get();
+      if(!std::getline(in, name) or name.empty())
+        throw std::runtime_error(path + " is not a capacity hint file");
+      site(name).restore(hint, samples);
+    }
+    if(!in.eof())
+      throw std::runtime_error(path + " is not a capacity hint file");
+  }
+};
+
+#define AISDI_CAPACITY_HINT_STRING(line) #line
+#define AISDI_CAPACITY_HINT_LINE(line) AISDI_CAPACITY_HINT_STRING(line)
+
+// The CapacityHintSite of the source line it appears on, looked up once.
+#define AISDI_ALLOCATION_SITE \
+  ([]() -> ::aisdi::CapacityHintSite& { \
+    static ::aisdi::CapacityHintSite& site = \
+      ::aisdi::CapacityHints::instance().site(__FILE__ ":" AISDI_CAPACITY_HINT_LINE(__LINE__)); \
+    return site; \
+  }())
+
+// Vector that starts with the capacity its allocation site's containers
+// usually end up needing and reports its own final size back on destruction:
+//   HintedVector<int> items(AISDI_ALLOCATION_SITE);
+// Fresh sites start at the Vector default. A copy reports to the same site;
+// assignment keeps the site the target was made at.
+template <typename Type, typename Stats = DefaultContainerStats>
+class HintedVector : public Vector<Type, Stats>
+{
+  CapacityHintSite* site;
+
+public:
+  explicit HintedVector(CapacityHintSite& site_)
+    : Vector<Type, Stats>(typename Vector<Type, Stats>::CapacityTag(), site_.getHint()),
+      site(&site_)
+  {}
+
+  HintedVector(const HintedVector& other) = default;
+  HintedVector(HintedVector&& other) = default;
+
+  HintedVector& operator=(const HintedVector& other)
+  {
+    Vector<Type, Stats>::operator=(other);
+    return *this;
+  }
+
+  HintedVector& operator=(HintedVector&& other)
+  {
+    Vector<Type, Stats>::operator=(std::move(other));
+    return *this;
+  }
+
+  ~HintedVector()
+  {
+    // a moved-from vector has no storage and says nothing about the site
+    if(this->getCapacity() != 0)
+      site->record(this->getSize());
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_CAPACITYHINTS_H
@@ -0,0 +1,255 @@
+#ifndef AISDI_LINEAR_COMPRESSEDVECTOR_H
+#define AISDI_LINEAR_COMPRESSEDVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "PackedVector.h"
+
+namespace aisdi
+{
+
+// Append-only vector of unsigned integers compressed in blocks of 64 values.
+// Each block stores its first value (frame of reference) and the zigzag-coded
+// deltas between neighbours, bit-packed with the smallest width that fits the
+// block. Near-sorted ids therefore take a few bits per element. A per-block
+// skip entry (first value, width, word offset) lets decoding start at any block
+// without touching the ones before it. The last, incomplete block is kept raw.
+class CompressedVector
+{
+public:
+  using size_type = std::size_t;
+  using value_type = std::uint64_t;
+
+  static const size_type blockSize = 64;
+
+private:
+  struct SkipEntry
+  {
+    std::uint64_t base;
+    size_type wordOffset;
+    unsigned width;
+  };
+
+  size_type vectorSize;
+  size_type blockCount;
+  size_type reservedBlocks;
+  SkipEntry* skips;
+  size_type usedWords;
+  size_type reservedWords;
+  std::uint64_t* words;
+  std::uint64_t tail[blockSize];
+
+  static std::uint64_t zigzagEncode(std::uint64_t current, std::uint64_t previous)
+  {
+    std::uint64_t delta = current - previous;
+    return (delta << 1) ^ (std::uint64_t)((std::int64_t)delta >> 63);
+  }
+
+  static std::uint64_t zigzagDecode(std::uint64_t coded)
+  {
+    return (coded >> 1) ^ (~(coded & 1) + 1);
+  }
+
+  template <typename Element>
+  static void grow(Element*& storage, size_type used, size_type& reserved, size_type needed)
+  {
+    if(needed <= reserved)
+      return;
+    size_type newReserved = reserved != 0 ? reserved * 2 : 16;
+    while(newReserved < needed)
+      newReserved *= 2;
+    auto newStorage = new Element[newReserved];
+    for(size_type i = 0; i != used; i++)
+      newStorage[i] = storage[i];
+    delete [] storage;
+    storage = newStorage;
+    reserved = newReserved;
+  }
+
+  void flushTail()
+  {
+    std::uint64_t deltas[blockSize];
+    std::uint64_t largest = 0;
+    deltas[0] = 0;
+    for(size_type i = 1; i != blockSize; i++)
+    {
+      deltas[i] = zigzagEncode(tail[i], tail[i - 1]);
+      largest |= deltas[i];
+    }
+    SkipEntry entry;
+    entry.base = tail[0];
+    entry.width = detail::bitWidth(largest);
+    entry.wordOffset = usedWords;
+
+    grow(skips, blockCount, reservedBlocks, blockCount + 1);
+    grow(words, usedWords, reservedWords, usedWords + entry.width);
+    detail::BlockKernels::instance().pack[entry.width](deltas, words + usedWords);
+    usedWords += entry.width;
+    skips[blockCount++] = entry;
+  }
+
+  void copyFrom(const CompressedVector& other)
+  {
+    vectorSize = other.vectorSize;
+    blockCount = other.blockCount;
+    reservedBlocks = other.blockCount;
+    skips = blockCount != 0 ? new SkipEntry[blockCount] : nullptr;
+    for(size_type i = 0; i != blockCount; i++)
+      skips[i] = other.skips[i];
+    usedWords = other.usedWords;
+    reservedWords = other.usedWords;
+    words = usedWords != 0 ? new std::uint64_t[usedWords] : nullptr;
+    for(size_type i = 0; i != usedWords; i++)
+      words[i] = other.words[i];
+    for(size_type i = 0; i != blockSize; i++)
+      tail[i] = other.tail[i];
+  }
+
+public:
+  CompressedVector()
+    : vectorSize(0), blockCount(0), reservedBlocks(0), skips(nullptr),
+      usedWords(0), reservedWords(0), words(nullptr)
+  {}
+
+  CompressedVector(std::initializer_list<std::uint64_t> l)
+    : CompressedVector()
+  {
+    for(auto i = l.begin(); i != l.end(); i++)
+      append(*i);
+  }
+
+  CompressedVector(const CompressedVector& other)
+  {
+    copyFrom(other);
+  }
+
+  CompressedVector(CompressedVector&& other)
+    : CompressedVector()
+  {
+    swap(other);
+  }
+
+  ~CompressedVector()
+  {
+    delete [] skips;
+    delete [] words;
+  }
+
+  CompressedVector& operator=(CompressedVector other)
+  {
+    swap(other);
+    return *this;
+  }
+
+  void swap(CompressedVector& other)
+  {
+    std::swap(vectorSize, other.vectorSize);
+    std::swap(blockCount, other.blockCount);
+    std::swap(reservedBlocks, other.reservedBlocks);
+    std::swap(skips, other.skips);
+    std::swap(usedWords, other.usedWords);
+    std::swap(reservedWords, other.reservedWords);
+    std::swap(words, other.words);
+    for(size_type i = 0; i != blockSize; i++)
+      std::swap(tail[i], other.tail[i]);
+  }
+
+  bool isEmpty() const
+  {
+    return vectorSize == 0;
+  }
+
+  size_type getSize() const
+  {
+    return vectorSize;
+  }
+
+  // Heap and inline bytes spent on the encoded data, skip table and raw tail.
+  size_type getBytes() const
+  {
+    return reservedWords * sizeof(std::uint64_t) + reservedBlocks * sizeof(SkipEntry) +
+           sizeof(tail);
+  }
+
+  void append(std::uint64_t item)
+  {
+    tail[vectorSize % blockSize] = item;
+    vectorSize++;
+    if(vectorSize % blockSize == 0)
+      flushTail();
+  }
+
+  size_type getBlockCount() const
+  {
+    return (vectorSize + blockSize - 1) / blockSize;
+  }
+
+  // Decodes block number block into out and returns how many values it holds.
+  size_type decodeBlock(size_type block, std::uint64_t* out) const
+  {
+    if(block >= getBlockCount())
+      throw std::out_of_range("Block out of compressed vector");
+    if(block == blockCount)
+    {
+      const size_type count = vectorSize - blockCount * blockSize;
+      for(size_type i = 0; i != count; i++)
+        out[i] = tail[i];
+      return count;
+    }
+    const SkipEntry& entry = skips[block];
+    detail::BlockKernels::instance().unpack[entry.width](words + entry.wordOffset, out);
+    std::uint64_t value = entry.base;
+    out[0] = value;
+    for(size_type i = 1; i != blockSize; i++)
+    {
+      value += zigzagDecode(out[i]);
+      out[i] = value;
+    }
+    return blockSize;
+  }
+
+  // Decodes count values starting at first; the skip table jumps straight to
+  // the block holding first.
+  void decode(size_type first, size_type count, std::uint64_t* out) const
+  {
+    if(first > vectorSize or count > vectorSize - first)
+      throw std::out_of_range("Can't decode range out of compressed vector");
+    std::uint64_t buffer[blockSize];
+    size_type block = first / blockSize;
+    size_type skip = first % blockSize;
+    while(count != 0)
+    {
+      const size_type decoded = decodeBlock(block++, buffer);
+      for(size_type i = skip; i != decoded and count != 0; i++, count--)
+        *out++ = buffer[i];
+      skip = 0;
+    }
+  }
+
+  void decode(std::uint64_t* out) const
+  {
+    decode(0, vectorSize, out);
+  }
+
+  std::uint64_t at(size_type index) const
+  {
+    if(index >= vectorSize)
+      throw std::out_of_range("Index out of compressed vector");
+    std::uint64_t value;
+    decode(index, 1, &value);
+    return value;
+  }
+};
+
+inline void swap(CompressedVector& first, CompressedVector& second)
+{
+  first.swap(second);
+}
+
+}
+
+#endif // AISDI_LINEAR_COMPRESSEDVECTOR_H
@@ -0,0 +1,237 @@
+#ifndef AISDI_LINEAR_CONCURRENTAPPENDVECTOR_H
+#define AISDI_LINEAR_CONCURRENTAPPENDVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace aisdi
+{
+
+// Append-only vector for many producer threads, without locks.
+// A producer claims a slot with one fetch_add on the reserved size and writes
+// it in place. Storage is a table of segments doubling in size (32, 64, 128...),
+// allocated on first use, so elements never move and references stay valid.
+// Readers see the published prefix: slots [0, getSize()) are all written,
+// and iterating them takes no locks.
+template <typename Type>
+class ConcurrentAppendVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using reference = Type&;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+private:
+  static const unsigned firstSegmentBits = 5;
+  static const unsigned maxSegments = 64 - firstSegmentBits;
+
+  struct Slot
+  {
+    value_type value;
+    std::atomic<bool> ready;
+
+    Slot()
+      : ready(false)
+    {}
+  };
+
+  std::atomic<Slot*> segments[maxSegments];
+  std::atomic<size_type> reservedSize;
+  std::atomic<size_type> publishedSize;
+
+  static unsigned segmentOf(size_type index)
+  {
+    const unsigned long long shifted = (unsigned long long)index + (1ull << firstSegmentBits);
+    return 63 - __builtin_clzll(shifted) - firstSegmentBits;
+  }
+
+  static size_type offsetIn(size_type index, unsigned segment)
+  {
+    return index + (size_type(1) << firstSegmentBits) - (size_type(1) << (segment + firstSegmentBits));
+  }
+
+  static size_type segmentLength(unsigned segment)
+  {
+    return size_type(1) << (segment + firstSegmentBits);
+  }
+
+  Slot& slotAt(size_type index) const
+  {
+    const unsigned segment = segmentOf(index);
+    return segments[segment].load(std::memory_order_acquire)[offsetIn(index, segment)];
+  }
+
+  Slot* segmentFor(unsigned segment)
+  {
+    Slot* current = segments[segment].load(std::memory_order_acquire);
+    if(current != nullptr)
+      return current;
+    Slot* fresh = new Slot[segmentLength(segment)];
+    if(segments[segment].compare_exchange_strong(current, fresh, std::memory_order_acq_rel))
+      return fresh;
+    // another producer installed it first
+    delete [] fresh;
+    return current;
+  }
+
+  bool isReady(size_type index) const
+  {
+    const unsigned segment = segmentOf(index);
+    Slot* slots = segments[segment].load(std::memory_order_acquire);
+    return slots != nullptr and slots[offsetIn(index, segment)].ready.load();
+  }
+
+  // Moves the published size over every consecutive ready slot. Any producer
+  // may do it, so a slow writer delays visibility but never blocks others.
+  // The ready flags and publishedSize use sequentially consistent operations:
+  // the producer that finishes last is then guaranteed to see the others'
+  // progress, so no ready slot is left unpublished.
+  void publish()
+  {
+    size_type published = publishedSize.load();
+    while(published < reservedSize.load() and isReady(published))
+    {
+      if(publishedSize.compare_exchange_weak(published, published + 1))
+        published++;
+    }
+  }
+
+public:
+  ConcurrentAppendVector()
+    : reservedSize(0), publishedSize(0)
+  {
+    for(unsigned i = 0; i != maxSegments; i++)
+      segments[i].store(nullptr, std::memory_order_relaxed);
+  }
+
+  ConcurrentAppendVector(const ConcurrentAppendVector&) = delete;
+  ConcurrentAppendVector& operator=(const ConcurrentAppendVector&) = delete;
+
+  ~ConcurrentAppendVector()
+  {
+    for(unsigned i = 0; i != maxSegments; i++)
+      delete [] segments[i].load(std::memory_order_relaxed);
+  }
+
+  // Number of elements readers may access; grows monotonically.
+  size_type getSize() const
+  {
+    return publishedSize.load();
+  }
+
+  bool isEmpty() const
+  {
+    return getSize() == 0;
+  }
+
+  // Returns the index the item was stored at. Safe to call from any thread.
+  size_type append(const Type& item)
+  {
+    const size_type index = reservedSize.fetch_add(1, std::memory_order_acq_rel);
+    const unsigned segment = segmentOf(index);
+    Slot& slot = segmentFor(segment)[offsetIn(index, segment)];
+    slot.value = item;
+    slot.ready.store(true);
+    publish();
+    return index;
+  }
+
+  const_reference operator[](size_type index) const
+  {
+    return slotAt(index).value;
+  }
+
+  const_reference at(size_type index) const
+  {
+    if(index >= getSize())
+      throw std::out_of_range("Index out of published part of vector");
+    return (*this)[index];
+  }
+
+  // Iterators may run up to the size published at the time they move.
+  const_iterator cbegin() const
+  {
+    return ConstIterator(this, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(this, getSize());
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+template <typename Type>
+class ConcurrentAppendVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename ConcurrentAppendVector::value_type;
+  using difference_type = typename ConcurrentAppendVector::difference_type;
+  using pointer = const Type*;
+  using reference = typename ConcurrentAppendVector::const_reference;
+
+  const ConcurrentAppendVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0)
+  {}
+
+  ConstIterator(const ConcurrentAppendVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or index >= pointerToVector->getSize())
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    return (*pointerToVector)[index];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index >= pointerToVector->getSize())
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_CONCURRENTAPPENDVECTOR_H
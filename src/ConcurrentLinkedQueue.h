@@ -0,0 +1,130 @@
+#ifndef AISDI_LINEAR_CONCURRENTLINKEDQUEUE_H
+#define AISDI_LINEAR_CONCURRENTLINKEDQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+#include "CacheLine.h"
+#include "EpochPool.h"
+
+namespace aisdi
+{
+
+// Unbounded lock-free FIFO queue for any number of threads (Michael & Scott).
+// The list always starts with a dummy node; head points at it and tail at the
+// last node or, briefly, the one before it - any thread that notices a
+// lagging tail swings it forward. Popped dummies are retired to an EpochPool,
+// which recycles them as new nodes once no thread can still be reading them.
+template <typename Type>
+class ConcurrentLinkedQueue
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+
+private:
+  struct Node : detail::PooledNode
+  {
+    Type value;
+    std::atomic<Node*> next;
+
+    Node()
+      : value(), next(nullptr)
+    {}
+  };
+
+  using Pool = detail::EpochPool<Node>;
+
+  mutable Pool pool;
+  detail::CacheLinePadded<std::atomic<Node*>> head;
+  detail::CacheLinePadded<std::atomic<Node*>> tail;
+
+public:
+  ConcurrentLinkedQueue()
+  {
+    Node* dummy = new Node();
+    head.value.store(dummy);
+    tail.value.store(dummy);
+  }
+
+  ConcurrentLinkedQueue(const ConcurrentLinkedQueue&) = delete;
+  ConcurrentLinkedQueue& operator=(const ConcurrentLinkedQueue&) = delete;
+
+  // No other thread may use the queue any more.
+  ~ConcurrentLinkedQueue()
+  {
+    Node* node = head.value.load();
+    while(node != nullptr)
+    {
+      Node* next = node->next.load();
+      delete node;
+      node = next;
+    }
+  }
+
+  // A snapshot: another thread may append or pop right after.
+  bool isEmpty() const
+  {
+    typename Pool::Guard guard(pool);
+    return head.value.load()->next.load() == nullptr;
+  }
+
+  void append(const Type& item)
+  {
+    typename Pool::Guard guard(pool);
+    Node* node = guard.allocate();
+    node->value = item;
+    node->next.store(nullptr, std::memory_order_relaxed);
+    for(;;)
+    {
+      Node* last = tail.value.load();
+      Node* next = last->next.load();
+      if(last != tail.value.load())
+        continue;
+      if(next != nullptr)
+      {
+        tail.value.compare_exchange_weak(last, next);
+        continue;
+      }
+      if(last->next.compare_exchange_weak(next, node))
+      {
+        tail.value.compare_exchange_strong(last, node);
+        return;
+      }
+    }
+  }
+
+  // Moves the first item into item and returns true, or returns false when
+  // the queue is empty.
+  bool popFirst(Type& item)
+  {
+    typename Pool::Guard guard(pool);
+    for(;;)
+    {
+      Node* first = head.value.load();
+      Node* last = tail.value.load();
+      Node* next = first->next.load();
+      if(first != head.value.load())
+        continue;
+      if(next == nullptr)
+        return false;
+      if(first == last)
+      {
+        tail.value.compare_exchange_weak(last, next);
+        continue;
+      }
+      if(head.value.compare_exchange_weak(first, next))
+      {
+        // next is the new dummy and only this thread reads its value; the
+        // guard keeps it from being recycled even if it gets popped meanwhile
+        item = std::move(next->value);
+        guard.retire(first);
+        return true;
+      }
+    }
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_CONCURRENTLINKEDQUEUE_H
@@ -0,0 +1,204 @@
+#ifndef AISDI_LINEAR_CONCURRENTORDEREDLIST_H
+#define AISDI_LINEAR_CONCURRENTORDEREDLIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "EpochPool.h"
+
+namespace aisdi
+{
+
+// Lock-free sorted set on a singly linked list (Harris, with Michael's
+// eager unlinking). Erasing first marks the node's next pointer - the low
+// bit - which logically deletes it and stops anyone linking behind it; the
+// node is then unlinked by the eraser or by whichever traversal meets it
+// first, and the thread that unlinks it retires it to the EpochPool.
+// contains() never writes and never restarts.
+template <typename Type, typename Compare = std::less<Type>>
+class ConcurrentOrderedList
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+
+private:
+  struct Node : detail::PooledNode
+  {
+    Type value;
+    // Node* of the successor, with the low bit set once this node is erased
+    std::atomic<std::uintptr_t> next;
+
+    Node()
+      : value(), next(0)
+    {}
+  };
+
+  using Pool = detail::EpochPool<Node>;
+  using Link = std::atomic<std::uintptr_t>;
+
+  mutable Pool pool;
+  Node* head;
+  Compare less;
+
+  static Node* pointerOf(std::uintptr_t link)
+  {
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t(1));
+  }
+
+  static bool isMarked(std::uintptr_t link)
+  {
+    return (link & 1) != 0;
+  }
+
+  static std::uintptr_t linkTo(Node* node)
+  {
+    return reinterpret_cast<std::uintptr_t>(node);
+  }
+
+  // Sets previous to the link that points at current, the first node not less
+  // than item, unlinking erased nodes on the way. Returns whether current
+  // holds item.
+  bool find(typename Pool::Guard& guard, const Type& item, Link*& previous, Node*& current)
+  {
+    for(;;)
+    {
+      previous = &head->next;
+      current = pointerOf(previous->load());
+      bool interrupted = false;
+      while(current != nullptr and !interrupted)
+      {
+        const std::uintptr_t next = current->next.load();
+        // previous changed under us: start again from the head
+        if(previous->load() != linkTo(current))
+        {
+          interrupted = true;
+          continue;
+        }
+        if(isMarked(next))
+        {
+          std::uintptr_t expected = linkTo(current);
+          if(previous->compare_exchange_strong(expected, next & ~std::uintptr_t(1)))
+          {
+            guard.retire(current);
+            current = pointerOf(next);
+          }
+          else
+            interrupted = true;
+          continue;
+        }
+        if(!less(current->value, item))
+          return !less(item, current->value);
+        previous = &current->next;
+        current = pointerOf(next);
+      }
+      if(!interrupted)
+        return false;
+    }
+  }
+
+public:
+  explicit ConcurrentOrderedList(const Compare& less_ = Compare())
+    : head(new Node()), less(less_)
+  {}
+
+  ConcurrentOrderedList(const ConcurrentOrderedList&) = delete;
+  ConcurrentOrderedList& operator=(const ConcurrentOrderedList&) = delete;
+
+  // No other thread may use the list any more.
+  ~ConcurrentOrderedList()
+  {
+    Node* node = head;
+    while(node != nullptr)
+    {
+      Node* next = pointerOf(node->next.load());
+      delete node;
+      node = next;
+    }
+  }
+
+  // A snapshot: O(n), and other threads may change the list meanwhile.
+  size_type getSize() const
+  {
+    typename Pool::Guard guard(pool);
+    size_type count = 0;
+    for(Node* node = pointerOf(head->next.load()); node != nullptr; )
+    {
+      const std::uintptr_t next = node->next.load();
+      if(!isMarked(next))
+        count++;
+      node = pointerOf(next);
+    }
+    return count;
+  }
+
+  bool isEmpty() const
+  {
+    return getSize() == 0;
+  }
+
+  bool contains(const Type& item) const
+  {
+    typename Pool::Guard guard(pool);
+    Node* node = pointerOf(head->next.load());
+    while(node != nullptr and less(node->value, item))
+      node = pointerOf(node->next.load());
+    return node != nullptr and !less(item, node->value) and !isMarked(node->next.load());
+  }
+
+  // Returns false when item was already present.
+  bool insert(const Type& item)
+  {
+    typename Pool::Guard guard(pool);
+    Node* node = nullptr;
+    for(;;)
+    {
+      Link* previous;
+      Node* current;
+      if(find(guard, item, previous, current))
+      {
+        // never published, but recycling it through the pool is still cheapest
+        if(node != nullptr)
+          guard.retire(node);
+        return false;
+      }
+      if(node == nullptr)
+      {
+        node = guard.allocate();
+        node->value = item;
+      }
+      node->next.store(linkTo(current), std::memory_order_relaxed);
+      std::uintptr_t expected = linkTo(current);
+      if(previous->compare_exchange_strong(expected, linkTo(node)))
+        return true;
+    }
+  }
+
+  // Returns false when item was not present.
+  bool erase(const Type& item)
+  {
+    typename Pool::Guard guard(pool);
+    for(;;)
+    {
+      Link* previous;
+      Node* current;
+      if(!find(guard, item, previous, current))
+        return false;
+      std::uintptr_t next = current->next.load();
+      if(isMarked(next) or !current->next.compare_exchange_strong(next, next | 1))
+        continue;
+      std::uintptr_t expected = linkTo(current);
+      if(previous->compare_exchange_strong(expected, next))
+        guard.retire(current);
+      else
+        find(guard, item, previous, current);
+      return true;
+    }
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_CONCURRENTORDEREDLIST_H
@@ -0,0 +1,236 @@
+#ifndef AISDI_LINEAR_CONTAINERSTATS_H
+#define AISDI_LINEAR_CONTAINERSTATS_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace aisdi
+{
+
+// What a container did to its storage over its lifetime. wastedBytes is the
+// reserved but unused space at the time the numbers are taken.
+struct ContainerStats
+{
+  std::size_t reallocations;
+  std::size_t elementsMoved;
+  std::size_t nodeAllocations;
+  std::size_t nodeFrees;
+  std::size_t peakCapacity;
+  std::size_t wastedBytes;
+
+  ContainerStats()
+    : reallocations(0), elementsMoved(0), nodeAllocations(0), nodeFrees(0),
+      peakCapacity(0), wastedBytes(0)
+  {}
+
+  ContainerStats& operator+=(const ContainerStats& other)
+  {
+    reallocations += other.reallocations;
+    elementsMoved += other.elementsMoved;
+    nodeAllocations += other.nodeAllocations;
+    nodeFrees += other.nodeFrees;
+    peakCapacity = peakCapacity > other.peakCapacity ? peakCapacity : other.peakCapacity;
+    wastedBytes += other.wastedBytes;
+    return *this;
+  }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const ContainerStats& stats)
+{
+  return out<<"reallocations="<<stats.reallocations<<" elementsMoved="<<stats.elementsMoved<<
+            " nodeAllocations="<<stats.nodeAllocations<<" nodeFrees="<<stats.nodeFrees<<
+            " peakCapacity="<<stats.peakCapacity<<" wastedBytes="<<stats.wastedBytes;
+}
+
+// Statistics policy of Vector and LinkedList. The containers derive from it
+// privately and call its hooks at every reallocation, shift and node
+// allocation. This one is empty and its hooks do nothing, so with it the
+// counting compiles away and the container keeps its size.
+struct NoContainerStats
+{
+  using Snapshot = ContainerStats (*)(const void*);
+
+  void trackContainer(const char*, const void*, Snapshot)
+  {}
+
+  void onCapacity(std::size_t)
+  {}
+
+  void onReallocation(std::size_t, std::size_t)
+  {}
+
+  void onElementsMoved(std::size_t)
+  {}
+
+  void onNodeAllocated()
+  {}
+
+  void onNodeFreed()
+  {}
+
+  ContainerStats counters() const
+  {
+    return ContainerStats();
+  }
+};
+
+class CountingContainerStats;
+
+// Every live container with CountingContainerStats, plus per-kind totals of
+// the destroyed ones. dump() reads the live containers' sizes, so call it
+// when they are not being modified or accept that the numbers are racy.
+class ContainerStatsRegistry
+{
+  friend class CountingContainerStats;
+
+  mutable std::mutex mutex;
+  CountingContainerStats* first;
+  std::map<std::string, ContainerStats> retired;
+  std::map<std::string, std::size_t> retiredCount;
+
+  ContainerStatsRegistry()
+    : first(nullptr)
+  {}
+
+  void add(CountingContainerStats* stats);
+  void remove(CountingContainerStats* stats);
+
+public:
+  static ContainerStatsRegistry& instance()
+  {
+    static ContainerStatsRegistry registry;
+    return registry;
+  }
+
+  // One line per live container, then one per kind of destroyed ones.
+  void dump(std::ostream& out) const;
+};
+
+// Counting policy: keeps the numbers and registers the container in
+// ContainerStatsRegistry. A copied container starts with fresh counters.
+class CountingContainerStats
+{
+  friend class ContainerStatsRegistry;
+
+public:
+  using Snapshot = ContainerStats (*)(const void*);
+
+private:
+  ContainerStats values;
+  const char* kind;
+  const void* owner;
+  Snapshot snapshot;
+  CountingContainerStats* previous;
+  CountingContainerStats* next;
+
+public:
+  CountingContainerStats()
+    : kind("container"), owner(nullptr), snapshot(nullptr), previous(nullptr), next(nullptr)
+  {
+    ContainerStatsRegistry::instance().add(this);
+  }
+
+  CountingContainerStats(const CountingContainerStats&)
+    : CountingContainerStats()
+  {}
+
+  CountingContainerStats& operator=(const CountingContainerStats&)
+  {
+    return *this;
+  }
+
+  ~CountingContainerStats()
+  {
+    ContainerStatsRegistry::instance().remove(this);
+  }
+
+  // snapshot(owner) returns the owner's counters including its current waste.
+  void trackContainer(const char* kind_, const void* owner_, Snapshot snapshot_)
+  {
+    kind = kind_;
+    owner = owner_;
+    snapshot = snapshot_;
+  }
+
+  void onCapacity(std::size_t capacity)
+  {
+    if(capacity > values.peakCapacity)
+      values.peakCapacity = capacity;
+  }
+
+  void onReallocation(std::size_t moved, std::size_t capacity)
+  {
+    values.reallocations++;
+    values.elementsMoved += moved;
+    onCapacity(capacity);
+  }
+
+  void onElementsMoved(std::size_t moved)
+  {
+    values.elementsMoved += moved;
+  }
+
+  void onNodeAllocated()
+  {
+    values.nodeAllocations++;
+  }
+
+  void onNodeFreed()
+  {
+    values.nodeFrees++;
+  }
+
+  ContainerStats counters() const
+  {
+    return values;
+  }
+};
+
+inline void ContainerStatsRegistry::add(CountingContainerStats* stats)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  stats->next = first;
+  if(first != nullptr)
+    first->previous = stats;
+  first = stats;
+}
+
+inline void ContainerStatsRegistry::remove(CountingContainerStats* stats)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(stats->previous != nullptr)
+    stats->previous->next = stats->next;
+  else
+    first = stats->next;
+  if(stats->next != nullptr)
+    stats->next->previous = stats->previous;
+  // by now the owner is (being) destroyed: keep only what the policy counted
+  retired[stats->kind] += stats->values;
+  retiredCount[stats->kind]++;
+}
+
+inline void ContainerStatsRegistry::dump(std::ostream& out) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for(const CountingContainerStats* stats = first; stats != nullptr; stats = stats->next)
+  {
+    const ContainerStats values = stats->snapshot != nullptr ? stats->snapshot(stats->owner)
+                                                             : stats->values;
+    out<<stats->kind<<" at "<<stats->owner<<": "<<values<<std::endl;
+  }
+  for(auto i = retired.begin(); i != retired.end(); i++)
+    out<<retiredCount.find(i->first)->second<<" destroyed "<<i->first<<": "<<i->second<<std::endl;
+}
+
+#ifdef AISDI_CONTAINER_STATS
+using DefaultContainerStats = CountingContainerStats;
+#else
+using DefaultContainerStats = NoContainerStats;
+#endif
+
+}
+
+#endif // AISDI_LINEAR_CONTAINERSTATS_H
@@ -0,0 +1,279 @@
+#ifndef AISDI_LINEAR_EPOCHPOOL_H
+#define AISDI_LINEAR_EPOCHPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "CacheLine.h"
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// Base of nodes managed by EpochPool; the links belong to the pool.
+struct PooledNode
+{
+  PooledNode* poolNext;
+  PooledNode* batchNext;
+
+  PooledNode()
+    : poolNext(nullptr), batchNext(nullptr)
+  {}
+};
+
+// Node allocator with epoch-based reclamation for lock-free containers.
+// Every operation on the container runs inside a Guard, which announces the
+// global epoch it started in. A retired node is recycled only once the global
+// epoch has moved two steps past the epoch it was retired in, and the epoch
+// moves only when every open guard has seen the current one - so no thread
+// can still hold a pointer to the node. Recycled nodes are handed out again
+// by allocate() without touching the heap; they keep their old contents.
+//
+// AdvanceInterval is how many retirements a slot makes between attempts to
+// move the epoch; use 1 for few, large nodes that should be recycled quickly.
+//
+// Guards borrow one of slotCount slots, which keep the retired and free
+// nodes; a thread reuses the same slot while it is free. Nodes freed into a
+// slot that already holds enough spill in batches to a shared lock-free stack.
+// That stack is safe from ABA because a node only returns to it after a
+// grace period, which waits for every guard that could have read it. Only
+// allocate() and retire() collect expired nodes, so a guard that just reads
+// never touches the shared stack.
+template <typename Node, std::size_t AdvanceInterval = 64>
+class EpochPool
+{
+public:
+  using size_type = std::size_t;
+
+  static const size_type slotCount = 64;
+
+private:
+  static const size_type localFreeLimit = 512;
+
+  struct Limbo
+  {
+    PooledNode* first;
+    std::uint64_t epoch;
+  };
+
+  struct Slot
+  {
+    std::atomic<bool> inUse;
+    // epoch * 2 + 1 while a guard is open, 0 otherwise
+    std::atomic<std::uint64_t> state;
+    Limbo limbo[3];
+    PooledNode* freeNodes;
+    size_type freeCount;
+    size_type retiredSinceAdvance;
+
+    Slot()
+      : inUse(false), state(0), freeNodes(nullptr), freeCount(0), retiredSinceAdvance(0)
+    {
+      for(auto& bucket : limbo)
+      {
+        bucket.first = nullptr;
+        bucket.epoch = 0;
+      }
+    }
+  };
+
+  CacheLinePadded<std::atomic<std::uint64_t>> globalEpoch;
+  CacheLinePadded<std::atomic<PooledNode*>> sharedBatches;
+  CacheLinePadded<Slot> slots[slotCount];
+
+  static size_type threadNumber()
+  {
+    static std::atomic<size_type> nextNumber(0);
+    static thread_local size_type number = nextNumber++;
+    return number;
+  }
+
+  size_type acquireSlot()
+  {
+    const size_type hint = threadNumber();
+    for(;;)
+    {
+      for(size_type i = 0; i != slotCount; i++)
+      {
+        const size_type index = (hint + i) % slotCount;
+        std::atomic<bool>& inUse = slots[index].value.inUse;
+        if(!inUse.load(std::memory_order_relaxed) and
+           !inUse.exchange(true, std::memory_order_acquire))
+          return index;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  static void deleteChain(PooledNode* node)
+  {
+    while(node != nullptr)
+    {
+      PooledNode* next = node->poolNext;
+      delete static_cast<Node*>(node);
+      node = next;
+    }
+  }
+
+  void recycle(Slot& slot, Limbo& bucket)
+  {
+    PooledNode* first = bucket.first;
+    bucket.first = nullptr;
+    if(first == nullptr)
+      return;
+    size_type count = 1;
+    PooledNode* last = first;
+    for(; last->poolNext != nullptr; last = last->poolNext)
+      count++;
+    if(slot.freeCount < localFreeLimit)
+    {
+      last->poolNext = slot.freeNodes;
+      slot.freeNodes = first;
+      slot.freeCount += count;
+      return;
+    }
+    PooledNode* top = sharedBatches.value.load(std::memory_order_relaxed);
+    do
+      first->batchNext = top;
+    while(!sharedBatches.value.compare_exchange_weak(top, first, std::memory_order_release,
+                                                     std::memory_order_relaxed));
+  }
+
+  void collect(Slot& slot)
+  {
+    const std::uint64_t epoch = globalEpoch.value.load();
+    for(auto& bucket : slot.limbo)
+      if(bucket.first != nullptr and bucket.epoch + 2 <= epoch)
+        recycle(slot, bucket);
+  }
+
+  void tryAdvance()
+  {
+    std::uint64_t epoch = globalEpoch.value.load();
+    for(auto& slot : slots)
+    {
+      const std::uint64_t state = slot.value.state.load();
+      if((state & 1) != 0 and (state >> 1) != epoch)
+        return;
+    }
+    globalEpoch.value.compare_exchange_strong(epoch, epoch + 1);
+  }
+
+  // Caller holds the slot's guard, which makes popping the shared stack safe.
+  Node* allocate(Slot& slot)
+  {
+    if(slot.freeNodes == nullptr)
+      collect(slot);
+    if(slot.freeNodes == nullptr)
+    {
+      PooledNode* batch = sharedBatches.value.load(std::memory_order_acquire);
+      while(batch != nullptr and
+            !sharedBatches.value.compare_exchange_weak(batch, batch->batchNext,
+                                                       std::memory_order_acquire))
+      {}
+      slot.freeNodes = batch;
+      slot.freeCount = 0;
+      for(PooledNode* node = batch; node != nullptr; node = node->poolNext)
+        slot.freeCount++;
+    }
+    if(slot.freeNodes == nullptr)
+      return new Node();
+    PooledNode* node = slot.freeNodes;
+    slot.freeNodes = node->poolNext;
+    slot.freeCount--;
+    node->poolNext = nullptr;
+    return static_cast<Node*>(node);
+  }
+
+  void retire(Slot& slot, Node* node)
+  {
+    const std::uint64_t epoch = globalEpoch.value.load();
+    Limbo& bucket = slot.limbo[epoch % 3];
+    // anything still here was retired three or more epochs ago
+    if(bucket.epoch != epoch)
+    {
+      recycle(slot, bucket);
+      bucket.epoch = epoch;
+    }
+    node->poolNext = bucket.first;
+    bucket.first = node;
+    if(++slot.retiredSinceAdvance == AdvanceInterval)
+    {
+      slot.retiredSinceAdvance = 0;
+      tryAdvance();
+      collect(slot);
+    }
+  }
+
+public:
+  class Guard
+  {
+    EpochPool& pool;
+    Slot& slot;
+
+  public:
+    explicit Guard(EpochPool& owner)
+      : pool(owner), slot(owner.slots[owner.acquireSlot()].value)
+    {
+      slot.state.store(pool.globalEpoch.value.load() * 2 + 1);
+    }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard()
+    {
+      slot.state.store(0, std::memory_order_release);
+      slot.inUse.store(false, std::memory_order_release);
+    }
+
+    // A default-constructed or recycled node; the caller sets every field.
+    Node* allocate()
+    {
+      return pool.allocate(slot);
+    }
+
+    // node must already be unreachable for threads entering a new guard.
+    void retire(Node* node)
+    {
+      pool.retire(slot, node);
+    }
+  };
+
+  EpochPool()
+  {
+    globalEpoch.value.store(1);
+    sharedBatches.value.store(nullptr);
+  }
+
+  EpochPool(const EpochPool&) = delete;
+  EpochPool& operator=(const EpochPool&) = delete;
+
+  // No guard may be open any more.
+  ~EpochPool()
+  {
+    for(auto& slot : slots)
+    {
+      for(auto& bucket : slot.value.limbo)
+        deleteChain(bucket.first);
+      deleteChain(slot.value.freeNodes);
+    }
+    PooledNode* batch = sharedBatches.value.load();
+    while(batch != nullptr)
+    {
+      PooledNode* next = batch->batchNext;
+      deleteChain(batch);
+      batch = next;
+    }
+  }
+};
+
+}
+
+}
+
+#endif // AISDI_LINEAR_EPOCHPOOL_H
@@ -0,0 +1,396 @@
+#ifndef AISDI_LINEAR_FLATMAP_H
+#define AISDI_LINEAR_FLATMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// Lower bound over a sorted array whose loop body compiles to a conditional
+// move: the trip count depends only on count, so there is nothing to mispredict.
+template <typename Key, typename Compare>
+std::size_t branchlessLowerBound(const Key* keys, std::size_t count, const Key& key,
+                                 const Compare& less)
+{
+  if(count == 0)
+    return 0;
+  const Key* base = keys;
+  while(count > 1)
+  {
+    const std::size_t half = count / 2;
+    base = less(base[half], key) ? base + half : base;
+    count -= half;
+  }
+  return (base - keys) + (less(*base, key) ? 1 : 0);
+}
+
+// Copy of the sorted keys in BFS (Eytzinger) order: the first levels of every
+// search share cache lines, and the next node to visit is computed, not loaded.
+template <typename Key, typename Compare>
+class EytzingerIndex
+{
+  Vector<Key> tree;
+  Vector<std::size_t> rank;
+
+  void fill(const Key* sorted, std::size_t count, std::size_t node, std::size_t& next)
+  {
+    if(node > count)
+      return;
+    fill(sorted, count, 2 * node, next);
+    tree.data()[node] = sorted[next];
+    rank.data()[node] = next;
+    next++;
+    fill(sorted, count, 2 * node + 1, next);
+  }
+
+public:
+  void build(const Key* sorted, std::size_t count)
+  {
+    tree = Vector<Key>();
+    rank = Vector<std::size_t>();
+    tree.reserve(count + 1);
+    rank.reserve(count + 1);
+    for(std::size_t i = 0; i != count + 1; i++)
+    {
+      tree.append(Key());
+      rank.append(0);
+    }
+    std::size_t next = 0;
+    fill(sorted, count, 1, next);
+  }
+
+  // Same result as branchlessLowerBound over the array the index was built from.
+  std::size_t lowerBound(const Key& key, const Compare& less) const
+  {
+    const std::size_t count = tree.getSize() - 1;
+    const Key* nodes = tree.data();
+    std::size_t node = 1;
+    while(node <= count)
+      node = 2 * node + (less(nodes[node], key) ? 1 : 0);
+    // drop the trailing right turns; what is left is the last left turn
+    node >>= __builtin_ffsl(~node);
+    return node == 0 ? count : rank.data()[node];
+  }
+};
+
+// Sorted keys shared by FlatMap and FlatSet.
+template <typename Key, typename Compare>
+class FlatKeys
+{
+public:
+  using size_type = std::size_t;
+
+  Vector<Key> keys;
+  Compare less;
+  bool eytzinger;
+  EytzingerIndex<Key, Compare> index;
+
+  explicit FlatKeys(const Compare& less_)
+    : less(less_), eytzinger(false)
+  {}
+
+  size_type lowerBound(const Key& key) const
+  {
+    if(eytzinger)
+      return index.lowerBound(key, less);
+    return branchlessLowerBound(keys.data(), keys.getSize(), key, less);
+  }
+
+  size_type indexOf(const Key& key) const
+  {
+    size_type position = lowerBound(key);
+    if(position != keys.getSize() and !less(key, keys.data()[position]))
+      return position;
+    return keys.getSize();
+  }
+
+  void refreshIndex()
+  {
+    if(eytzinger)
+      index.build(keys.data(), keys.getSize());
+  }
+
+  bool isNewLast(const Vector<Key>& merged, const Key& key) const
+  {
+    return merged.isEmpty() or less(merged.data()[merged.getSize() - 1], key);
+  }
+};
+
+}
+
+// Read-mostly ordered map on two parallel Vectors (sorted keys, values).
+// Lookups are a branchless binary search, or an Eytzinger-layout search after
+// useEytzingerLayout(true). Single inserts/erases shift the arrays; use
+// insertBulk() to add many pairs with one sort and one merge.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap
+{
+public:
+  using size_type = std::size_t;
+  using key_type = Key;
+  using mapped_type = Value;
+
+private:
+  detail::FlatKeys<Key, Compare> sorted;
+  Vector<Value> mappedValues;
+
+public:
+  explicit FlatMap(const Compare& less = Compare())
+    : sorted(less)
+  {}
+
+  bool isEmpty() const
+  {
+    return sorted.keys.isEmpty();
+  }
+
+  size_type getSize() const
+  {
+    return sorted.keys.getSize();
+  }
+
+  // Keeps an Eytzinger copy of the keys for lookups. Every modification then
+  // rebuilds it in O(n), so enable it for tables built in bulk.
+  void useEytzingerLayout(bool enabled)
+  {
+    sorted.eytzinger = enabled;
+    sorted.refreshIndex();
+  }
+
+  bool contains(const Key& key) const
+  {
+    return sorted.indexOf(key) != getSize();
+  }
+
+  // Position of key in sorted order, or getSize() when it is absent.
+  size_type indexOf(const Key& key) const
+  {
+    return sorted.indexOf(key);
+  }
+
+  Value& at(const Key& key)
+  {
+    size_type position = sorted.indexOf(key);
+    if(position == getSize())
+      throw std::out_of_range("Key not found in flat map");
+    return mappedValues.data()[position];
+  }
+
+  const Value& at(const Key& key) const
+  {
+    return const_cast<FlatMap*>(this)->at(key);
+  }
+
+  // Inserts the pair unless key is already present; returns whether it did.
+  bool insert(const Key& key, const Value& value)
+  {
+    size_type position = sorted.lowerBound(key);
+    if(position != getSize() and !sorted.less(key, sorted.keys.data()[position]))
+      return false;
+    sorted.keys.insert(sorted.keys.cbegin() + position, key);
+    mappedValues.insert(mappedValues.cbegin() + position, value);
+    sorted.refreshIndex();
+    return true;
+  }
+
+  bool erase(const Key& key)
+  {
+    size_type position = sorted.indexOf(key);
+    if(position == getSize())
+      return false;
+    sorted.keys.erase(sorted.keys.cbegin() + position);
+    mappedValues.erase(mappedValues.cbegin() + position);
+    sorted.refreshIndex();
+    return true;
+  }
+
+  // Adds a range of std::pair<Key, Value>. Keys already in the map, and later
+  // duplicates within the range, are ignored - the same as repeated insert().
+  template <typename InputIterator>
+  void insertBulk(InputIterator first, InputIterator last)
+  {
+    Vector<std::pair<Key, Value>> staged;
+    for(; first != last; ++first)
+      staged.append(*first);
+    auto& less = sorted.less;
+    std::stable_sort(staged.data(), staged.data() + staged.getSize(),
+                     [&less](const std::pair<Key, Value>& a, const std::pair<Key, Value>& b)
+                     { return less(a.first, b.first); });
+
+    Vector<Key> mergedKeys;
+    Vector<Value> mergedValues;
+    mergedKeys.reserve(getSize() + staged.getSize());
+    mergedValues.reserve(getSize() + staged.getSize());
+    const Key* keys = sorted.keys.data();
+    const Value* values = mappedValues.data();
+    size_type i = 0;
+    size_type j = 0;
+    while(i != getSize() or j != staged.getSize())
+    {
+      const std::pair<Key, Value>* item = staged.data() + j;
+      if(j == staged.getSize() or (i != getSize() and !less(item->first, keys[i])))
+      {
+        mergedKeys.append(keys[i]);
+        mergedValues.append(values[i]);
+        i++;
+        continue;
+      }
+      if(sorted.isNewLast(mergedKeys, item->first))
+      {
+        mergedKeys.append(item->first);
+        mergedValues.append(item->second);
+      }
+      j++;
+    }
+    sorted.keys = std::move(mergedKeys);
+    mappedValues = std::move(mergedValues);
+    sorted.refreshIndex();
+  }
+
+  const Key& keyAt(size_type index) const
+  {
+    if(index >= getSize())
+      throw std::out_of_range("Index out of flat map");
+    return sorted.keys.data()[index];
+  }
+
+  Value& valueAt(size_type index)
+  {
+    if(index >= getSize())
+      throw std::out_of_range("Index out of flat map");
+    return mappedValues.data()[index];
+  }
+
+  const Value& valueAt(size_type index) const
+  {
+    return const_cast<FlatMap*>(this)->valueAt(index);
+  }
+
+  // Sorted keys and the values in the same order, for scans.
+  const Vector<Key>& keys() const
+  {
+    return sorted.keys;
+  }
+
+  const Vector<Value>& values() const
+  {
+    return mappedValues;
+  }
+};
+
+// Sorted set on a Vector; see FlatMap for the lookup and bulk-insert strategy.
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet
+{
+public:
+  using size_type = std::size_t;
+  using key_type = Key;
+  using const_iterator = typename Vector<Key>::const_iterator;
+
+private:
+  detail::FlatKeys<Key, Compare> sorted;
+
+public:
+  explicit FlatSet(const Compare& less = Compare())
+    : sorted(less)
+  {}
+
+  bool isEmpty() const
+  {
+    return sorted.keys.isEmpty();
+  }
+
+  size_type getSize() const
+  {
+    return sorted.keys.getSize();
+  }
+
+  void useEytzingerLayout(bool enabled)
+  {
+    sorted.eytzinger = enabled;
+    sorted.refreshIndex();
+  }
+
+  bool contains(const Key& key) const
+  {
+    return sorted.indexOf(key) != getSize();
+  }
+
+  size_type indexOf(const Key& key) const
+  {
+    return sorted.indexOf(key);
+  }
+
+  bool insert(const Key& key)
+  {
+    size_type position = sorted.lowerBound(key);
+    if(position != getSize() and !sorted.less(key, sorted.keys.data()[position]))
+      return false;
+    sorted.keys.insert(sorted.keys.cbegin() + position, key);
+    sorted.refreshIndex();
+    return true;
+  }
+
+  bool erase(const Key& key)
+  {
+    size_type position = sorted.indexOf(key);
+    if(position == getSize())
+      return false;
+    sorted.keys.erase(sorted.keys.cbegin() + position);
+    sorted.refreshIndex();
+    return true;
+  }
+
+  template <typename InputIterator>
+  void insertBulk(InputIterator first, InputIterator last)
+  {
+    Vector<Key> staged;
+    for(; first != last; ++first)
+      staged.append(*first);
+    std::sort(staged.data(), staged.data() + staged.getSize(), sorted.less);
+
+    Vector<Key> merged;
+    merged.reserve(getSize() + staged.getSize());
+    const Key* keys = sorted.keys.data();
+    const Key* items = staged.data();
+    size_type i = 0;
+    size_type j = 0;
+    while(i != getSize() or j != staged.getSize())
+    {
+      const Key& next = (j == staged.getSize() or
+                         (i != getSize() and !sorted.less(items[j], keys[i]))) ? keys[i++] : items[j++];
+      if(sorted.isNewLast(merged, next))
+        merged.append(next);
+    }
+    sorted.keys = std::move(merged);
+    sorted.refreshIndex();
+  }
+
+  const Vector<Key>& keys() const
+  {
+    return sorted.keys;
+  }
+
+  const_iterator begin() const
+  {
+    return sorted.keys.cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return sorted.keys.cend();
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_FLATMAP_H
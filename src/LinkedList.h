@@ -5,11 +5,15 @@
 #include <initializer_list>
 #include <stdexcept>
 
+#include "ContainerStats.h"
+
 namespace aisdi
 {
 
-template <typename Type>
-	class LinkedList
+// Stats is the statistics policy (see ContainerStats.h); the default
+// NoContainerStats compiles the counting out.
+template <typename Type, typename Stats = DefaultContainerStats>
+	class LinkedList : private Stats
 	{
 	public:
 		using difference_type = std::ptrdiff_t;
@@ -55,16 +59,41 @@ template <typename Type>
 		Node* sentinel;
 		size_type size;
 
+		Node* createNode(const Type& item, Node* prev, Node* next)
+		{
+			Stats::onNodeAllocated();
+			Stats::onCapacity(size + 1);
+			return new Node(item, prev, next);
+		}
+
+		void destroyNode(Node* node)
+		{
+			Stats::onNodeFreed();
+			delete node;
+		}
+
+		static ContainerStats statsOf(const void* owner)
+		{
+			return static_cast<const LinkedList*>(owner)->stats();
+		}
+
+		void track()
+		{
+			Stats::trackContainer("LinkedList", this, &LinkedList::statsOf);
+		}
+
 		LinkedList()
 		{
 			sentinel = new Node();
 			size = 0;
+			track();
 		}
 
 		LinkedList(std::initializer_list<Type> l)
 		{
 			sentinel = new Node();
 			size = 0;
+			track();
 			for(auto i = l.begin(); i != l.end(); i++)
 			{
 				append(*i);
@@ -72,9 +101,11 @@ template <typename Type>
 		}
 
 		LinkedList(const LinkedList& other)
+			: Stats()
 		{
 			sentinel = new Node();
 			size = 0;
+			track();
 			for(const_iterator i = other.begin(); i != other.end(); i++)
 			{
 				append(*i);
@@ -87,31 +118,36 @@ template <typename Type>
 			sentinel = other.sentinel;
 			other.size = 0;
 			other.sentinel = nullptr;
+			track();
 		}
 
-		~LinkedList()
+		// Frees every node but the sentinel; a moved-from list has none.
+		void destroyNodes()
 		{
-      if(sentinel == nullptr)
-        return;
+			if(sentinel == nullptr)
+				return;
 			Node* next;
 			for(Node* loop = sentinel->next; loop != sentinel; loop = next)
 			{
 				next = loop->next;
-				delete loop;
+				destroyNode(loop);
 			}
 		}
 
+		~LinkedList()
+		{
+			destroyNodes();
+			delete sentinel;
+		}
+
 		LinkedList& operator=(const LinkedList& other)
 		{
 
 			if(this == &other)
 				return *this;
-			Node* next;
-			for(Node* loop = sentinel->next; loop != sentinel; loop = next)
-			{
-				next = loop->next;
-				delete loop;
-			}
+			destroyNodes();
+			if(sentinel == nullptr)
+				sentinel = new Node();
 			size = 0;
 			for(const_iterator i = other.begin();i!=other.end();i++)
 			{
@@ -125,16 +161,13 @@ template <typename Type>
 			if(this == &other)
 				return *this;
 
-			Node* next;
-			for(Node* loop = sentinel->next; loop != sentinel; loop = next)
-			{
-				next = loop->next;
-				delete loop;
-			}
+			// our emptied sentinel goes to other, which stays a valid empty list
+			destroyNodes();
+			Node* emptied = sentinel;
 			sentinel = other.sentinel;
 			size = other.size;
 			other.size = 0;
-			other.sentinel= nullptr;
+			other.sentinel = emptied;
 			return *this;
 		}
 /*
@@ -161,15 +194,25 @@ template <typename Type>
 			return size;
 		}
 
+		// peakCapacity is the most elements the list held; wastedBytes counts
+		// the links of every node and of the sentinel.
+		ContainerStats stats() const
+		{
+			ContainerStats result = Stats::counters();
+			if(sentinel != nullptr)
+				result.wastedBytes = (size + 1) * 2 * sizeof(Node*);
+			return result;
+		}
+
 		void append(const Type& item)
 		{
-			new Node(item, sentinel->prev, sentinel);
+			createNode(item, sentinel->prev, sentinel);
 			size++;
 		}
 
 		void prepend(const Type& item)
 		{
-			new Node(item, sentinel, sentinel->next);
+			createNode(item, sentinel, sentinel->next);
 			size++;
 		}
 
@@ -180,7 +223,7 @@ template <typename Type>
         prepend(item);
         return;
       }
-			new Node(item, (insertPosition - 1).node, insertPosition.node);
+			createNode(item, (insertPosition - 1).node, insertPosition.node);
 			size++;
 		}
 
@@ -189,7 +232,7 @@ template <typename Type>
 			if(isEmpty() == 1)
 				throw std::out_of_range ("List is empty, can't pop anything");
 			value_type temporary = sentinel->next->value;
-			delete sentinel->next;
+			destroyNode(sentinel->next);
 			size--;
 			return temporary;
 		}
@@ -199,7 +242,7 @@ template <typename Type>
 			if(isEmpty() == 1)
 				throw std::out_of_range ("List is empty, can't pop anything");
 			value_type temporary = sentinel->prev->value;
-			delete sentinel->prev;
+			destroyNode(sentinel->prev);
 			size--;
 			return temporary;
 		}
@@ -210,7 +253,7 @@ template <typename Type>
 				throw std::out_of_range ("List is empty, can't pop anything");
 			if(possition.node == sentinel)
 				throw std::out_of_range ("Can't go there");
-			delete possition.node;
+			destroyNode(possition.node);
       size--;
 		}
 
@@ -220,13 +263,34 @@ template <typename Type>
 				throw std::out_of_range ("List is empty, can't pop anything");
 			if(firstIncluded.node == sentinel)
 				throw std::out_of_range ("Can't go there");
-			for(auto i = firstIncluded; i != lastExcluded; i++)
+			for(auto i = firstIncluded; i != lastExcluded;)
 			{
-				delete i.node;
+				Node* toDelete = i.node;
+				i++;
+				destroyNode(toDelete);
 				size--;
 			}
 		}
 
+		// Unlinks every element matching predicate in one traversal.
+		template <typename Predicate>
+		size_type removeIf(Predicate predicate)
+		{
+			size_type removed = 0;
+			Node* next;
+			for(Node* loop = sentinel->next; loop != sentinel; loop = next)
+			{
+				next = loop->next;
+				if(predicate(loop->value))
+				{
+					destroyNode(loop);
+					removed++;
+				}
+			}
+			size -= removed;
+			return removed;
+		}
+
 		iterator begin()
 		{
 			return Iterator(sentinel->next,sentinel);
@@ -258,8 +322,8 @@ template <typename Type>
 		}
 	};
 
-template <typename Type>
-	class LinkedList<Type>::ConstIterator
+template <typename Type, typename Stats>
+	class LinkedList<Type, Stats>::ConstIterator
 	{
 	public:
 		using iterator_category = std::bidirectional_iterator_tag;
@@ -376,8 +440,8 @@ template <typename Type>
 		}
   };
 
-template <typename Type>
-			class LinkedList<Type>::Iterator : public LinkedList<Type>::ConstIterator
+template <typename Type, typename Stats>
+			class LinkedList<Type, Stats>::Iterator : public LinkedList<Type, Stats>::ConstIterator
 			{
 			public:
 				using pointer = typename LinkedList::pointer;
@@ -0,0 +1,255 @@
+#ifndef AISDI_LINEAR_MAPPEDVECTOR_H
+#define AISDI_LINEAR_MAPPEDVECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "VectorFile.h"
+
+namespace aisdi
+{
+
+// Read-only view of a file written by Vector::saveTo. The file is mmap'ed,
+// so opening costs a header check regardless of size and pages are faulted in
+// on first touch. Iteration follows Vector's ConstIterator contract.
+template <typename Type>
+class MappedVector
+{
+  static_assert(std::is_trivially_copyable<Type>::value,
+                "MappedVector requires a trivially copyable element type");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = const Type*;
+  using reference = const Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+private:
+  void* mapping;
+  size_type mappingSize;
+  const Type* elements;
+  size_type vectorSize;
+
+  void unmap()
+  {
+    if(mapping != nullptr)
+      munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    elements = nullptr;
+    vectorSize = 0;
+  }
+
+public:
+  MappedVector()
+    : mapping(nullptr), mappingSize(0), elements(nullptr), vectorSize(0)
+  {}
+
+  explicit MappedVector(const std::string& path)
+    : MappedVector()
+  {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if(descriptor < 0)
+      throw std::runtime_error("Can't open " + path);
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 or
+       (size_type)status.st_size < detail::vectorFileDataOffset)
+    {
+      ::close(descriptor);
+      throw std::runtime_error(path + " is not a vector file");
+    }
+    mappingSize = status.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if(mapping == MAP_FAILED)
+    {
+      mapping = nullptr;
+      throw std::runtime_error("Can't map " + path);
+    }
+    const auto& header = *static_cast<const detail::VectorFileHeader*>(mapping);
+    try
+    {
+      detail::checkVectorFileHeader<Type>(header, mappingSize, path);
+    }
+    catch(...)
+    {
+      unmap();
+      throw;
+    }
+    elements = reinterpret_cast<const Type*>(static_cast<const char*>(mapping) +
+                                             detail::vectorFileDataOffset);
+    vectorSize = header.elementCount;
+  }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& other)
+    : mapping(other.mapping), mappingSize(other.mappingSize), elements(other.elements),
+      vectorSize(other.vectorSize)
+  {
+    other.mapping = nullptr;
+    other.unmap();
+  }
+
+  MappedVector& operator=(MappedVector&& other)
+  {
+    if(this != &other)
+    {
+      unmap();
+      mapping = other.mapping;
+      mappingSize = other.mappingSize;
+      elements = other.elements;
+      vectorSize = other.vectorSize;
+      other.mapping = nullptr;
+      other.unmap();
+    }
+    return *this;
+  }
+
+  ~MappedVector()
+  {
+    unmap();
+  }
+
+  bool isEmpty() const
+  {
+    return vectorSize == 0;
+  }
+
+  size_type getSize() const
+  {
+    return vectorSize;
+  }
+
+  const_pointer data() const
+  {
+    return elements;
+  }
+
+  const_reference operator[](size_type index) const
+  {
+    return elements[index];
+  }
+
+  const_iterator cbegin() const
+  {
+    return ConstIterator(this, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(this, vectorSize);
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+template <typename Type>
+class MappedVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename MappedVector::value_type;
+  using difference_type = typename MappedVector::difference_type;
+  using pointer = typename MappedVector::const_pointer;
+  using reference = typename MappedVector::const_reference;
+
+  const MappedVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0)
+  {}
+
+  ConstIterator(const MappedVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or pointerToVector->vectorSize <= index)
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    return pointerToVector->elements[index];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index == pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(index == 0)
+      throw std::out_of_range("Can't decrease iterator");
+    index--;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result(*this);
+    --(*this);
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const
+  {
+    difference_type target = (difference_type)index + d;
+    if(pointerToVector == nullptr or target < 0 or target > (difference_type)pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase/decrease iterator");
+    return ConstIterator(pointerToVector, (size_type)target);
+  }
+
+  ConstIterator operator-(difference_type d) const
+  {
+    return operator+(-d);
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_MAPPEDVECTOR_H
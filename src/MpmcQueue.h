@@ -0,0 +1,145 @@
+#ifndef AISDI_LINEAR_MPMCQUEUE_H
+#define AISDI_LINEAR_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "CacheLine.h"
+
+namespace aisdi
+{
+
+// Bounded FIFO queue for any number of producer and consumer threads
+// (D. Vyukov's design). Cells live in one contiguous array and each carries a
+// sequence number that says whose turn it is: a cell at position p is free
+// for the producer of p when sequence == p, and holds an item for the
+// consumer of p when sequence == p + 1. Claiming a position is one CAS on the
+// shared enqueue or dequeue counter; nothing is allocated after construction.
+// Capacity is rounded up to a power of two.
+template <typename Type>
+class MpmcQueue
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+
+private:
+  struct Cell
+  {
+    std::atomic<size_type> sequence;
+    Type value;
+  };
+
+  detail::CacheLinePadded<std::atomic<size_type>> enqueuePosition;
+  detail::CacheLinePadded<std::atomic<size_type>> dequeuePosition;
+  size_type capacity;
+  size_type mask;
+  Cell* cells;
+
+  static size_type roundUpToPowerOfTwo(size_type value)
+  {
+    size_type result = 1;
+    while(result < value)
+      result *= 2;
+    return result;
+  }
+
+public:
+  explicit MpmcQueue(size_type requestedCapacity)
+    : capacity(roundUpToPowerOfTwo(requestedCapacity)), mask(capacity - 1),
+      cells(nullptr)
+  {
+    if(requestedCapacity == 0)
+      throw std::out_of_range("Queue capacity must be positive");
+    cells = new Cell[capacity];
+    for(size_type i = 0; i != capacity; i++)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    enqueuePosition.value.store(0, std::memory_order_relaxed);
+    dequeuePosition.value.store(0, std::memory_order_relaxed);
+  }
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  ~MpmcQueue()
+  {
+    delete [] cells;
+  }
+
+  size_type getCapacity() const
+  {
+    return capacity;
+  }
+
+  // Exact only when no thread is pushing or popping; otherwise a snapshot.
+  size_type getSize() const
+  {
+    const size_type dequeued = dequeuePosition.value.load(std::memory_order_acquire);
+    const size_type enqueued = enqueuePosition.value.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  bool isEmpty() const
+  {
+    return getSize() == 0;
+  }
+
+  // Returns false without waiting when the queue is full.
+  bool tryPush(const Type& item)
+  {
+    size_type position = enqueuePosition.value.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      Cell& cell = cells[position & mask];
+      const size_type sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t lag = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+      if(lag == 0)
+      {
+        if(enqueuePosition.value.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed))
+        {
+          cell.value = item;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(lag < 0)
+        return false;
+      else
+        position = enqueuePosition.value.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false without waiting when the queue is empty.
+  bool tryPop(Type& item)
+  {
+    size_type position = dequeuePosition.value.load(std::memory_order_relaxed);
+    for(;;)
+    {
+      Cell& cell = cells[position & mask];
+      const size_type sequence = cell.sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t lag = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1);
+      if(lag == 0)
+      {
+        if(dequeuePosition.value.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed))
+        {
+          item = std::move(cell.value);
+          // free the cell for the producer one lap ahead
+          cell.sequence.store(position + capacity, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(lag < 0)
+        return false;
+      else
+        position = dequeuePosition.value.load(std::memory_order_relaxed);
+    }
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_MPMCQUEUE_H
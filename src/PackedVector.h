@@ -0,0 +1,537 @@
+#ifndef AISDI_LINEAR_PACKEDVECTOR_H
+#define AISDI_LINEAR_PACKEDVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AISDI_PACKING_AVX2
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define AISDI_PACKING_NEON
+#include <arm_neon.h>
+#endif
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+inline std::uint64_t lowBitsMask(unsigned bits)
+{
+  return bits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+}
+
+inline unsigned bitWidth(std::uint64_t value)
+{
+  unsigned width = 0;
+  while(value != 0)
+  {
+    width++;
+    value >>= 1;
+  }
+  return width;
+}
+
+// 64 values of Bits bits occupy exactly Bits words, so a packed stream can be
+// processed in independent 64-value blocks. These are the portable scalar
+// kernels: one value at a time, with a branch where a value crosses words.
+// Compilers don't vectorize them; SimdBitPacking below does the unpacking.
+template <unsigned Bits>
+struct BitPacking
+{
+  static void unpack64(const std::uint64_t* in, std::uint64_t* out)
+  {
+    const std::uint64_t mask = lowBitsMask(Bits);
+    for(unsigned j = 0; j != 64; j++)
+    {
+      const unsigned bit = j * Bits;
+      const unsigned offset = bit & 63;
+      std::uint64_t value = in[bit >> 6] >> offset;
+      if(offset + Bits > 64)
+        value |= in[(bit >> 6) + 1] << (64 - offset);
+      out[j] = value & mask;
+    }
+  }
+
+  static void pack64(const std::uint64_t* in, std::uint64_t* out)
+  {
+    for(unsigned w = 0; w != Bits; w++)
+      out[w] = 0;
+    for(unsigned j = 0; j != 64; j++)
+    {
+      const unsigned bit = j * Bits;
+      const unsigned offset = bit & 63;
+      out[bit >> 6] |= in[j] << offset;
+      if(offset + Bits > 64)
+        out[(bit >> 6) + 1] |= in[j] >> (64 - offset);
+    }
+  }
+};
+
+template <>
+struct BitPacking<0>
+{
+  static void unpack64(const std::uint64_t*, std::uint64_t* out)
+  {
+    for(unsigned j = 0; j != 64; j++)
+      out[j] = 0;
+  }
+
+  static void pack64(const std::uint64_t*, std::uint64_t*)
+  {}
+};
+
+// Word and bit offset of value j of a block, and the word its top bits
+// spill into - clamped to the block, where a value that doesn't cross words
+// only gets bits shifted out by the mask from it.
+template <unsigned Bits>
+struct BlockLayout
+{
+  static unsigned word(unsigned j)
+  {
+    return j * Bits >> 6;
+  }
+
+  static unsigned nextWord(unsigned j)
+  {
+    return word(j) + 1 < Bits ? word(j) + 1 : Bits - 1;
+  }
+
+  static unsigned offset(unsigned j)
+  {
+    return j * Bits & 63;
+  }
+};
+
+#if defined(AISDI_PACKING_AVX2)
+
+// Unpacks four values per step: gathers the low and spill words of each
+// lane, and shifts every lane by its own offset. A spill shifted by 64 is
+// 0, so no lane branches. Built for AVX2 whatever -march says; BlockKernels
+// only picks it on CPUs that have it.
+template <unsigned Bits>
+struct SimdBitPacking
+{
+  __attribute__((target("avx2")))
+  static void unpack64(const std::uint64_t* in, std::uint64_t* out)
+  {
+    using Layout = BlockLayout<Bits>;
+    const long long* words = reinterpret_cast<const long long*>(in);
+    const __m256i mask = _mm256_set1_epi64x((long long)lowBitsMask(Bits));
+    const __m256i wordBits = _mm256_set1_epi64x(64);
+    for(unsigned j = 0; j != 64; j += 4)
+    {
+      const __m256i low = _mm256_setr_epi64x(Layout::word(j), Layout::word(j + 1),
+                                             Layout::word(j + 2), Layout::word(j + 3));
+      const __m256i next = _mm256_setr_epi64x(Layout::nextWord(j), Layout::nextWord(j + 1),
+                                              Layout::nextWord(j + 2), Layout::nextWord(j + 3));
+      const __m256i offset = _mm256_setr_epi64x(Layout::offset(j), Layout::offset(j + 1),
+                                                Layout::offset(j + 2), Layout::offset(j + 3));
+      const __m256i value = _mm256_or_si256(
+        _mm256_srlv_epi64(_mm256_i64gather_epi64(words, low, 8), offset),
+        _mm256_sllv_epi64(_mm256_i64gather_epi64(words, next, 8), _mm256_sub_epi64(wordBits, offset)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j), _mm256_and_si256(value, mask));
+    }
+  }
+};
+
+inline const char* simdPackingName()
+{
+  return "avx2";
+}
+
+inline bool simdPackingAvailable()
+{
+  return __builtin_cpu_supports("avx2");
+}
+
+#elif defined(AISDI_PACKING_NEON)
+
+// Unpacks two values per step, shifting each lane by its own offset; a
+// negative count shifts right and a spill shifted by 64 is 0.
+template <unsigned Bits>
+struct SimdBitPacking
+{
+  static void unpack64(const std::uint64_t* in, std::uint64_t* out)
+  {
+    using Layout = BlockLayout<Bits>;
+    const uint64x2_t mask = vdupq_n_u64(lowBitsMask(Bits));
+    for(unsigned j = 0; j != 64; j += 2)
+    {
+      const uint64x2_t low = vcombine_u64(vcreate_u64(in[Layout::word(j)]), vcreate_u64(in[Layout::word(j + 1)]));
+      const uint64x2_t next = vcombine_u64(vcreate_u64(in[Layout::nextWord(j)]),
+                                           vcreate_u64(in[Layout::nextWord(j + 1)]));
+      const int64x2_t offset = vcombine_s64(vcreate_s64(Layout::offset(j)), vcreate_s64(Layout::offset(j + 1)));
+      const uint64x2_t value = vorrq_u64(vshlq_u64(low, vnegq_s64(offset)),
+                                         vshlq_u64(next, vsubq_s64(vdupq_n_s64(64), offset)));
+      vst1q_u64(out + j, vandq_u64(value, mask));
+    }
+  }
+};
+
+inline const char* simdPackingName()
+{
+  return "neon";
+}
+
+inline bool simdPackingAvailable()
+{
+  return true;
+}
+
+#else
+
+template <unsigned Bits>
+struct SimdBitPacking : BitPacking<Bits>
+{};
+
+inline const char* simdPackingName()
+{
+  return "scalar";
+}
+
+inline bool simdPackingAvailable()
+{
+  return false;
+}
+
+#endif
+
+using BlockKernel = void (*)(const std::uint64_t*, std::uint64_t*);
+
+template <unsigned Bits>
+struct BlockKernelTable
+{
+  static void fill(BlockKernel* unpack, BlockKernel* scalarUnpack, BlockKernel* pack)
+  {
+    unpack[Bits] = &SimdBitPacking<Bits>::unpack64;
+    scalarUnpack[Bits] = &BitPacking<Bits>::unpack64;
+    pack[Bits] = &BitPacking<Bits>::pack64;
+    BlockKernelTable<Bits - 1>::fill(unpack, scalarUnpack, pack);
+  }
+};
+
+template <>
+struct BlockKernelTable<0>
+{
+  static void fill(BlockKernel* unpack, BlockKernel* scalarUnpack, BlockKernel* pack)
+  {
+    unpack[0] = scalarUnpack[0] = &BitPacking<0>::unpack64;
+    pack[0] = &BitPacking<0>::pack64;
+  }
+};
+
+// Runtime-width dispatch to the specialised kernels above. unpack holds the
+// SIMD kernels where the CPU runs them and the scalar ones otherwise;
+// scalarUnpack always the scalar ones, to compare against. Packing is scalar.
+struct BlockKernels
+{
+  BlockKernel unpack[65];
+  BlockKernel scalarUnpack[65];
+  BlockKernel pack[65];
+  const char* unpackName;
+
+  BlockKernels()
+  {
+    BlockKernelTable<64>::fill(unpack, scalarUnpack, pack);
+    unpackName = simdPackingName();
+    if(!simdPackingAvailable())
+    {
+      for(unsigned width = 0; width != 65; width++)
+        unpack[width] = scalarUnpack[width];
+      unpackName = "scalar";
+    }
+  }
+
+  static const BlockKernels& instance()
+  {
+    static const BlockKernels kernels;
+    return kernels;
+  }
+};
+
+}
+
+// Vector of unsigned integers stored with a fixed width of Bits bits each.
+// Random access is O(1) (one or two word reads); bulk decoding with unpack()
+// runs 64 values at a time through the width-specialised kernel, SIMD where
+// the CPU has it.
+template <unsigned Bits>
+class PackedVector
+{
+  static_assert(Bits >= 1 and Bits <= 64, "PackedVector width must be in 1..64 bits");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = std::uint64_t;
+
+  class ConstIterator;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+private:
+  size_type vectorSize;
+  size_type reservedWords;
+  std::uint64_t* words;
+
+  static size_type wordsFor(size_type count)
+  {
+    return (count * Bits + 63) / 64;
+  }
+
+  void reallocate()
+  {
+    // keep whole 64-value blocks so unpack() may always read Bits words at a time
+    size_type newReserved = reservedWords != 0 ? reservedWords * 2 : Bits;
+    auto newWords = new std::uint64_t[newReserved]();
+    for(size_type i = 0; i != reservedWords; i++)
+      newWords[i] = words[i];
+    delete [] words;
+    words = newWords;
+    reservedWords = newReserved;
+  }
+
+  void store(size_type index, std::uint64_t item)
+  {
+    const size_type bit = index * Bits;
+    const unsigned offset = bit & 63;
+    const std::uint64_t mask = detail::lowBitsMask(Bits);
+    std::uint64_t* word = words + (bit >> 6);
+    word[0] = (word[0] & ~(mask << offset)) | (item << offset);
+    if(offset + Bits > 64)
+    {
+      const unsigned spilled = offset + Bits - 64;
+      word[1] = (word[1] & ~detail::lowBitsMask(spilled)) | (item >> (64 - offset));
+    }
+  }
+
+public:
+  PackedVector()
+    : vectorSize(0), reservedWords(0), words(nullptr)
+  {}
+
+  PackedVector(std::initializer_list<std::uint64_t> l)
+    : PackedVector()
+  {
+    for(auto i = l.begin(); i != l.end(); i++)
+      append(*i);
+  }
+
+  PackedVector(const PackedVector& other)
+    : vectorSize(other.vectorSize), reservedWords(other.reservedWords),
+      words(other.reservedWords != 0 ? new std::uint64_t[other.reservedWords] : nullptr)
+  {
+    for(size_type i = 0; i != reservedWords; i++)
+      words[i] = other.words[i];
+  }
+
+  PackedVector(PackedVector&& other)
+    : vectorSize(other.vectorSize), reservedWords(other.reservedWords), words(other.words)
+  {
+    other.vectorSize = 0;
+    other.reservedWords = 0;
+    other.words = nullptr;
+  }
+
+  ~PackedVector()
+  {
+    delete [] words;
+  }
+
+  PackedVector& operator=(PackedVector other)
+  {
+    std::swap(vectorSize, other.vectorSize);
+    std::swap(reservedWords, other.reservedWords);
+    std::swap(words, other.words);
+    return *this;
+  }
+
+  bool isEmpty() const
+  {
+    return vectorSize == 0;
+  }
+
+  size_type getSize() const
+  {
+    return vectorSize;
+  }
+
+  // Heap bytes held by the packed storage.
+  size_type getBytes() const
+  {
+    return reservedWords * sizeof(std::uint64_t);
+  }
+
+  void append(std::uint64_t item)
+  {
+    if((item & ~detail::lowBitsMask(Bits)) != 0)
+      throw std::out_of_range("Value doesn't fit in packed vector width");
+    if(wordsFor(vectorSize + 1) > reservedWords)
+      reallocate();
+    store(vectorSize, item);
+    vectorSize++;
+  }
+
+  std::uint64_t popLast()
+  {
+    if(isEmpty())
+      throw std::out_of_range("Can't delete last element in empty vector");
+    std::uint64_t result = (*this)[vectorSize - 1];
+    store(vectorSize - 1, 0);
+    vectorSize--;
+    return result;
+  }
+
+  void set(size_type index, std::uint64_t item)
+  {
+    if(index >= vectorSize)
+      throw std::out_of_range("Index out of packed vector");
+    if((item & ~detail::lowBitsMask(Bits)) != 0)
+      throw std::out_of_range("Value doesn't fit in packed vector width");
+    store(index, item);
+  }
+
+  std::uint64_t operator[](size_type index) const
+  {
+    const size_type bit = index * Bits;
+    const unsigned offset = bit & 63;
+    const std::uint64_t* word = words + (bit >> 6);
+    std::uint64_t value = word[0] >> offset;
+    if(offset + Bits > 64)
+      value |= word[1] << (64 - offset);
+    return value & detail::lowBitsMask(Bits);
+  }
+
+  std::uint64_t at(size_type index) const
+  {
+    if(index >= vectorSize)
+      throw std::out_of_range("Index out of packed vector");
+    return (*this)[index];
+  }
+
+  // Decodes count values starting at first into out.
+  void unpack(size_type first, size_type count, std::uint64_t* out) const
+  {
+    if(first > vectorSize or count > vectorSize - first)
+      throw std::out_of_range("Can't unpack range out of packed vector");
+    size_type index = first;
+    const size_type last = first + count;
+    while(index != last and (index & 63) != 0)
+      *out++ = (*this)[index++];
+    const detail::BlockKernel unpack64 = detail::BlockKernels::instance().unpack[Bits];
+    while(last - index >= 64)
+    {
+      unpack64(words + (index / 64) * Bits, out);
+      out += 64;
+      index += 64;
+    }
+    while(index != last)
+      *out++ = (*this)[index++];
+  }
+
+  void unpack(std::uint64_t* out) const
+  {
+    unpack(0, vectorSize, out);
+  }
+
+  const_iterator cbegin() const
+  {
+    return ConstIterator(this, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(this, vectorSize);
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+// Yields values rather than references - packed elements have no address.
+template <unsigned Bits>
+class PackedVector<Bits>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::uint64_t;
+  using difference_type = typename PackedVector::difference_type;
+  using pointer = const std::uint64_t*;
+  using reference = std::uint64_t;
+
+  const PackedVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0)
+  {}
+
+  ConstIterator(const PackedVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or pointerToVector->vectorSize <= index)
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    return (*pointerToVector)[index];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index == pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(index == 0)
+      throw std::out_of_range("Can't decrease iterator");
+    index--;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result(*this);
+    --(*this);
+    return result;
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_PACKEDVECTOR_H
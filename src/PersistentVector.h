@@ -0,0 +1,523 @@
+#ifndef AISDI_LINEAR_PERSISTENTVECTOR_H
+#define AISDI_LINEAR_PERSISTENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace aisdi
+{
+
+// Immutable vector with structural sharing: a 32-way radix-balanced trie
+// plus a separate tail leaf. Every modifying operation returns a new version
+// that shares all untouched nodes with the old one, so append/set/popLast
+// copy at most one root-to-leaf path (O(log32 n)) instead of the whole array.
+// Use transient() for bulk builds - it mutates nodes it owns in place.
+template <typename Type>
+class PersistentVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+  using const_pointer = const Type*;
+  using const_reference = const Type&;
+
+  class ConstIterator;
+  class Transient;
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  static const unsigned bits = 5;
+  static const size_type width = size_type(1) << bits;
+  static const size_type mask = width - 1;
+
+private:
+  // Nodes created by persistent operations have owner 0; a transient stamps
+  // the nodes it creates with its own id and may then modify them in place.
+  struct Node
+  {
+    unsigned long owner;
+    explicit Node(unsigned long owner_) : owner(owner_) {}
+    virtual ~Node() {}
+  };
+
+  using NodePtr = std::shared_ptr<Node>;
+
+  struct Branch : Node
+  {
+    NodePtr children[width];
+    explicit Branch(unsigned long owner_) : Node(owner_) {}
+  };
+
+  struct Leaf : Node
+  {
+    value_type values[width];
+    explicit Leaf(unsigned long owner_) : Node(owner_) {}
+  };
+
+  using BranchPtr = std::shared_ptr<Branch>;
+  using LeafPtr = std::shared_ptr<Leaf>;
+
+  size_type count;
+  unsigned shift;
+  BranchPtr root;
+  LeafPtr tail;
+
+  PersistentVector(size_type count_, unsigned shift_, BranchPtr root_, LeafPtr tail_)
+    : count(count_), shift(shift_), root(std::move(root_)), tail(std::move(tail_))
+  {}
+
+  static unsigned long nextOwner()
+  {
+    static std::atomic<unsigned long> counter(0);
+    return ++counter;
+  }
+
+  static size_type tailOffset(size_type size)
+  {
+    if(size < width)
+      return 0;
+    return ((size - 1) >> bits) << bits;
+  }
+
+  static BranchPtr copyBranch(const Branch& node, unsigned long owner)
+  {
+    auto result = std::make_shared<Branch>(owner);
+    for(size_type i = 0; i != width; i++)
+      result->children[i] = node.children[i];
+    return result;
+  }
+
+  static LeafPtr copyLeaf(const Leaf& node, size_type used, unsigned long owner)
+  {
+    auto result = std::make_shared<Leaf>(owner);
+    for(size_type i = 0; i != used; i++)
+      result->values[i] = node.values[i];
+    return result;
+  }
+
+  static BranchPtr editableBranch(const BranchPtr& node, unsigned long owner)
+  {
+    if(owner != 0 and node->owner == owner)
+      return node;
+    return copyBranch(*node, owner);
+  }
+
+  static LeafPtr editableLeaf(const LeafPtr& node, size_type used, unsigned long owner)
+  {
+    if(owner != 0 and node->owner == owner)
+      return node;
+    return copyLeaf(*node, used, owner);
+  }
+
+  static NodePtr newPath(unsigned level, const NodePtr& node, unsigned long owner)
+  {
+    if(level == 0)
+      return node;
+    auto result = std::make_shared<Branch>(owner);
+    result->children[0] = newPath(level - bits, node, owner);
+    return result;
+  }
+
+  // Hangs a full tail under parent; size is the element count including the tail.
+  static BranchPtr pushTail(size_type size, unsigned level, const BranchPtr& parent,
+                            const LeafPtr& tailNode, unsigned long owner)
+  {
+    auto result = editableBranch(parent, owner);
+    size_type subIndex = ((size - 1) >> level) & mask;
+    if(level == bits)
+    {
+      result->children[subIndex] = tailNode;
+      return result;
+    }
+    auto child = std::static_pointer_cast<Branch>(parent->children[subIndex]);
+    if(child)
+      result->children[subIndex] = pushTail(size, level - bits, child, tailNode, owner);
+    else
+      result->children[subIndex] = newPath(level - bits, tailNode, owner);
+    return result;
+  }
+
+  static BranchPtr popTail(size_type size, unsigned level, const BranchPtr& node,
+                           unsigned long owner)
+  {
+    size_type subIndex = ((size - 2) >> level) & mask;
+    if(level > bits)
+    {
+      auto child = std::static_pointer_cast<Branch>(node->children[subIndex]);
+      auto newChild = popTail(size, level - bits, child, owner);
+      if(!newChild and subIndex == 0)
+        return nullptr;
+      auto result = editableBranch(node, owner);
+      result->children[subIndex] = newChild;
+      return result;
+    }
+    if(subIndex == 0)
+      return nullptr;
+    auto result = editableBranch(node, owner);
+    result->children[subIndex] = nullptr;
+    return result;
+  }
+
+  static BranchPtr assocPath(unsigned level, const BranchPtr& node, size_type index,
+                             const Type& item, unsigned long owner)
+  {
+    auto result = editableBranch(node, owner);
+    size_type subIndex = (index >> level) & mask;
+    if(level == bits)
+    {
+      auto leaf = std::static_pointer_cast<Leaf>(node->children[subIndex]);
+      auto newLeaf = editableLeaf(leaf, width, owner);
+      newLeaf->values[index & mask] = item;
+      result->children[subIndex] = newLeaf;
+      return result;
+    }
+    auto child = std::static_pointer_cast<Branch>(node->children[subIndex]);
+    result->children[subIndex] = assocPath(level - bits, child, index, item, owner);
+    return result;
+  }
+
+  static const Leaf* leafFor(size_type size, unsigned levels, const BranchPtr& rootNode,
+                             const LeafPtr& tailNode, size_type index)
+  {
+    if(index >= tailOffset(size))
+      return tailNode.get();
+    const Node* node = rootNode.get();
+    for(unsigned level = levels; level > 0; level -= bits)
+      node = static_cast<const Branch*>(node)->children[(index >> level) & mask].get();
+    return static_cast<const Leaf*>(node);
+  }
+
+  const Leaf* leafFor(size_type index) const
+  {
+    return leafFor(count, shift, root, tail, index);
+  }
+
+  // Shared by the persistent and transient paths; owner 0 means "copy everything".
+  static void doAppend(size_type& size, unsigned& levels, BranchPtr& rootNode,
+                       LeafPtr& tailNode, const Type& item, unsigned long owner)
+  {
+    size_type inTail = size - tailOffset(size);
+    if(inTail < width)
+    {
+      tailNode = editableLeaf(tailNode, inTail, owner);
+      tailNode->values[inTail] = item;
+      size++;
+      return;
+    }
+    if((size >> bits) > (size_type(1) << levels))
+    {
+      auto newRoot = std::make_shared<Branch>(owner);
+      newRoot->children[0] = rootNode;
+      newRoot->children[1] = newPath(levels, tailNode, owner);
+      rootNode = newRoot;
+      levels += bits;
+    }
+    else
+    {
+      rootNode = pushTail(size, levels, rootNode, tailNode, owner);
+    }
+    tailNode = std::make_shared<Leaf>(owner);
+    tailNode->values[0] = item;
+    size++;
+  }
+
+  static void doSet(size_type size, unsigned levels, BranchPtr& rootNode,
+                    LeafPtr& tailNode, size_type index, const Type& item, unsigned long owner)
+  {
+    if(index >= size)
+      throw std::out_of_range("Can't set element out of persistent vector");
+    size_type offset = tailOffset(size);
+    if(index >= offset)
+    {
+      tailNode = editableLeaf(tailNode, size - offset, owner);
+      tailNode->values[index & mask] = item;
+      return;
+    }
+    rootNode = assocPath(levels, rootNode, index, item, owner);
+  }
+
+  static void doPopLast(size_type& size, unsigned& levels, BranchPtr& rootNode,
+                        LeafPtr& tailNode, unsigned long owner)
+  {
+    if(size == 0)
+      throw std::out_of_range("Can't pop last element from empty persistent vector");
+    if(size == 1)
+    {
+      size = 0;
+      levels = bits;
+      rootNode = std::make_shared<Branch>(owner);
+      tailNode = std::make_shared<Leaf>(owner);
+      return;
+    }
+    size_type inTail = size - tailOffset(size);
+    if(inTail > 1)
+    {
+      tailNode = editableLeaf(tailNode, inTail - 1, owner);
+      size--;
+      return;
+    }
+    const Leaf* previous = leafFor(size, levels, rootNode, tailNode, size - 2);
+    tailNode = copyLeaf(*previous, width, owner);
+    auto newRoot = popTail(size, levels, rootNode, owner);
+    if(!newRoot)
+      newRoot = std::make_shared<Branch>(owner);
+    if(levels > bits and !newRoot->children[1])
+    {
+      newRoot = std::static_pointer_cast<Branch>(newRoot->children[0]);
+      levels -= bits;
+    }
+    rootNode = newRoot;
+    size--;
+  }
+
+public:
+  PersistentVector()
+    : count(0), shift(bits), root(std::make_shared<Branch>(0)), tail(std::make_shared<Leaf>(0))
+  {}
+
+  PersistentVector(std::initializer_list<Type> l)
+    : PersistentVector()
+  {
+    Transient builder = transient();
+    for(auto i = l.begin(); i != l.end(); i++)
+      builder.append(*i);
+    *this = builder.persistent();
+  }
+
+  bool isEmpty() const
+  {
+    return count == 0;
+  }
+
+  size_type getSize() const
+  {
+    return count;
+  }
+
+  PersistentVector append(const Type& item) const
+  {
+    PersistentVector result(*this);
+    doAppend(result.count, result.shift, result.root, result.tail, item, 0);
+    return result;
+  }
+
+  PersistentVector set(size_type index, const Type& item) const
+  {
+    PersistentVector result(*this);
+    doSet(result.count, result.shift, result.root, result.tail, index, item, 0);
+    return result;
+  }
+
+  PersistentVector popLast() const
+  {
+    PersistentVector result(*this);
+    doPopLast(result.count, result.shift, result.root, result.tail, 0);
+    return result;
+  }
+
+  const_reference operator[](size_type index) const
+  {
+    return leafFor(index)->values[index & mask];
+  }
+
+  const_reference at(size_type index) const
+  {
+    if(index >= count)
+      throw std::out_of_range("Index out of persistent vector");
+    return (*this)[index];
+  }
+
+  const_reference last() const
+  {
+    if(isEmpty())
+      throw std::out_of_range("Persistent vector is empty");
+    return (*this)[count - 1];
+  }
+
+  Transient transient() const
+  {
+    return Transient(*this);
+  }
+
+  const_iterator cbegin() const
+  {
+    return ConstIterator(this, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(this, count);
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+// Batch-mutable view of a PersistentVector. Nodes the transient has already
+// copied are modified in place, so a bulk build costs about as much as
+// appending to a plain array. persistent() freezes the current contents;
+// the transient remains usable and copies on its next write.
+template <typename Type>
+class PersistentVector<Type>::Transient
+{
+  size_type count;
+  unsigned shift;
+  BranchPtr root;
+  LeafPtr tail;
+  unsigned long owner;
+
+public:
+  explicit Transient(const PersistentVector& source)
+    : count(source.count), shift(source.shift), root(source.root), tail(source.tail),
+      owner(nextOwner())
+  {}
+
+  bool isEmpty() const
+  {
+    return count == 0;
+  }
+
+  size_type getSize() const
+  {
+    return count;
+  }
+
+  Transient& append(const Type& item)
+  {
+    doAppend(count, shift, root, tail, item, owner);
+    return *this;
+  }
+
+  Transient& set(size_type index, const Type& item)
+  {
+    doSet(count, shift, root, tail, index, item, owner);
+    return *this;
+  }
+
+  Transient& popLast()
+  {
+    doPopLast(count, shift, root, tail, owner);
+    return *this;
+  }
+
+  const_reference operator[](size_type index) const
+  {
+    return leafFor(count, shift, root, tail, index)->values[index & mask];
+  }
+
+  PersistentVector persistent()
+  {
+    owner = nextOwner();
+    return PersistentVector(count, shift, root, tail);
+  }
+};
+
+template <typename Type>
+class PersistentVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename PersistentVector::value_type;
+  using difference_type = typename PersistentVector::difference_type;
+  using pointer = typename PersistentVector::const_pointer;
+  using reference = typename PersistentVector::const_reference;
+
+  const PersistentVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0), leaf(nullptr), leafBase(0)
+  {}
+
+  ConstIterator(const PersistentVector* other, size_type other2)
+    : pointerToVector(other), index(other2), leaf(nullptr), leafBase(0)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or pointerToVector->count <= index)
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    // Walking the trie once per 32 elements keeps iteration close to array speed.
+    if(leaf == nullptr or (index & ~mask) != leafBase)
+    {
+      leafBase = index & ~mask;
+      leaf = pointerToVector->leafFor(index);
+    }
+    return leaf->values[index & mask];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index == pointerToVector->count)
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(index == 0)
+      throw std::out_of_range("Can't decrease iterator");
+    index--;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result(*this);
+    --(*this);
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const
+  {
+    difference_type target = (difference_type)index + d;
+    if(pointerToVector == nullptr or target < 0 or target > (difference_type)pointerToVector->count)
+      throw std::out_of_range("Can't increase/decrease iterator");
+    return ConstIterator(pointerToVector, (size_type)target);
+  }
+
+  ConstIterator operator-(difference_type d) const
+  {
+    return operator+(-d);
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  mutable const Leaf* leaf;
+  mutable size_type leafBase;
+};
+
+}
+
+#endif // AISDI_LINEAR_PERSISTENTVECTOR_H
@@ -0,0 +1,147 @@
+#ifndef AISDI_LINEAR_RCUVECTOR_H
+#define AISDI_LINEAR_RCUVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "EpochPool.h"
+#include "Vector.h"
+
+namespace aisdi
+{
+
+// Read-mostly Vector in read-copy-update style. Readers open a Snapshot, which
+// announces itself to an EpochPool and loads the current buffer: no locks, no
+// retries, and no writes to anything other readers touch (acquiring one of
+// the pool's slots takes a bounded number of steps while fewer than
+// EpochPool::slotCount snapshots are open). Writers are serialised by a
+// mutex; each update copies the current Vector into a recycled buffer,
+// applies the change there and publishes it with one atomic exchange. The
+// old buffer is reused only after every snapshot that could see it closed.
+template <typename Type>
+class RcuVector
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+
+private:
+  struct Buffer : detail::PooledNode
+  {
+    Vector<Type> items;
+  };
+
+  // retire every replaced buffer promptly: there are few of them, and big
+  using Pool = detail::EpochPool<Buffer, 1>;
+
+  mutable Pool pool;
+  std::atomic<Buffer*> current;
+  std::mutex writerMutex;
+
+  void publish(typename Pool::Guard& guard, Buffer* fresh)
+  {
+    Buffer* old = current.exchange(fresh);
+    guard.retire(old);
+  }
+
+public:
+  // Read access to the version current when it was opened; later updates
+  // don't affect it. Keep it short-lived: it holds back buffer reuse.
+  class Snapshot
+  {
+    typename Pool::Guard guard;
+    const Vector<Type>* items;
+
+  public:
+    explicit Snapshot(const RcuVector& vector)
+      : guard(vector.pool), items(&vector.current.load()->items)
+    {}
+
+    const Vector<Type>& operator*() const
+    {
+      return *items;
+    }
+
+    const Vector<Type>* operator->() const
+    {
+      return items;
+    }
+  };
+
+  RcuVector()
+    : current(new Buffer())
+  {}
+
+  explicit RcuVector(const Vector<Type>& items)
+    : RcuVector()
+  {
+    current.load()->items = items;
+  }
+
+  RcuVector(const RcuVector&) = delete;
+  RcuVector& operator=(const RcuVector&) = delete;
+
+  // No snapshot may be open any more.
+  ~RcuVector()
+  {
+    delete current.load();
+  }
+
+  // Runs read(items) on a snapshot and returns its result.
+  template <typename Read>
+  auto read(Read read) const -> decltype(read(std::declval<const Vector<Type>&>()))
+  {
+    Snapshot snapshot(*this);
+    return read(*snapshot);
+  }
+
+  size_type getSize() const
+  {
+    Snapshot snapshot(*this);
+    return snapshot->getSize();
+  }
+
+  bool isEmpty() const
+  {
+    return getSize() == 0;
+  }
+
+  // Applies modify(Vector<Type>&) to a copy of the current contents and
+  // publishes the result. Batch changes into one call - each call copies.
+  template <typename Modify>
+  void update(Modify modify)
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    typename Pool::Guard guard(pool);
+    Buffer* fresh = guard.allocate();
+    // reuses the recycled buffer's storage when it is big enough
+    fresh->items = current.load()->items;
+    try
+    {
+      modify(fresh->items);
+    }
+    catch(...)
+    {
+      // never published, so it may go straight back to the pool
+      guard.retire(fresh);
+      throw;
+    }
+    publish(guard, fresh);
+  }
+
+  // Publishes items as the new contents without copying.
+  void assign(Vector<Type> items)
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    typename Pool::Guard guard(pool);
+    Buffer* fresh = guard.allocate();
+    fresh->items = std::move(items);
+    publish(guard, fresh);
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_RCUVECTOR_H
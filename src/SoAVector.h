@@ -0,0 +1,511 @@
+#ifndef AISDI_LINEAR_SOAVECTOR_H
+#define AISDI_LINEAR_SOAVECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace aisdi
+{
+
+// Contiguous view of one column of a SoAVector. Only valid until the next
+// operation that changes the vector's size.
+template <typename Type>
+class ColumnSpan
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type*;
+  using reference = Type&;
+
+  ColumnSpan(pointer data_, size_type size_)
+    : spanData(data_), spanSize(size_)
+  {}
+
+  pointer data() const
+  {
+    return spanData;
+  }
+
+  size_type getSize() const
+  {
+    return spanSize;
+  }
+
+  bool isEmpty() const
+  {
+    return spanSize == 0;
+  }
+
+  reference operator[](size_type index) const
+  {
+    return spanData[index];
+  }
+
+  pointer begin() const
+  {
+    return spanData;
+  }
+
+  pointer end() const
+  {
+    return spanData + spanSize;
+  }
+
+private:
+  pointer spanData;
+  size_type spanSize;
+};
+
+namespace detail
+{
+
+template <std::size_t... Indices>
+struct IndexSequence
+{};
+
+template <std::size_t N, std::size_t... Indices>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...>
+{};
+
+template <std::size_t... Indices>
+struct MakeIndexSequence<0, Indices...>
+{
+  using type = IndexSequence<Indices...>;
+};
+
+// Evaluates a pack expansion left to right without C++17 fold expressions.
+using Swallow = int[];
+
+}
+
+// Vector of records stored as struct-of-arrays: every field lives in its own
+// contiguous column, so a scan over one field touches only that field's bytes.
+// Rows are appended/erased as a whole; columns are read through column<I>().
+template <typename... Fields>
+class SoAVector
+{
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+
+  template <std::size_t Index>
+  using field_type = typename std::tuple_element<Index, value_type>::type;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+private:
+  using Indices = typename detail::MakeIndexSequence<sizeof...(Fields)>::type;
+
+  size_type vectorSize;
+  size_type reservedSize;
+  std::tuple<Fields*...> columns;
+
+  template <std::size_t... I>
+  void allocateColumns(detail::IndexSequence<I...>)
+  {
+    (void)detail::Swallow{0, (std::get<I>(columns) = new field_type<I>[reservedSize], 0)...};
+  }
+
+  template <std::size_t... I>
+  void releaseColumns(detail::IndexSequence<I...>)
+  {
+    (void)detail::Swallow{0, (delete [] std::get<I>(columns), std::get<I>(columns) = nullptr, 0)...};
+  }
+
+  template <std::size_t... I>
+  void copyColumns(const SoAVector& other, detail::IndexSequence<I...>)
+  {
+    (void)detail::Swallow{0, (copyColumn(std::get<I>(columns), std::get<I>(other.columns),
+                                         other.vectorSize), 0)...};
+  }
+
+  template <std::size_t... I>
+  void reallocateColumns(size_type newReserved, detail::IndexSequence<I...>)
+  {
+    (void)detail::Swallow{0, (growColumn(std::get<I>(columns), newReserved), 0)...};
+  }
+
+  template <typename Field>
+  void growColumn(Field*& column, size_type newReserved)
+  {
+    auto newColumn = new Field[newReserved];
+    for(size_type i = 0; i != vectorSize; i++)
+      newColumn[i] = std::move(column[i]);
+    delete [] column;
+    column = newColumn;
+  }
+
+  template <typename Field>
+  static void copyColumn(Field* target, const Field* source, size_type count)
+  {
+    for(size_type i = 0; i != count; i++)
+      target[i] = source[i];
+  }
+
+  template <std::size_t... I>
+  void storeRow(detail::IndexSequence<I...>, size_type index, const Fields&... items)
+  {
+    (void)detail::Swallow{0, (std::get<I>(columns)[index] = items, 0)...};
+  }
+
+  template <std::size_t... I>
+  void shiftRowsDown(size_type first, size_type last, detail::IndexSequence<I...>)
+  {
+    (void)detail::Swallow{0, (shiftColumn(std::get<I>(columns), first, last), 0)...};
+  }
+
+  template <typename Field>
+  void shiftColumn(Field* column, size_type first, size_type last)
+  {
+    for(size_type i = last; i != vectorSize; i++)
+      column[i - last + first] = std::move(column[i]);
+  }
+
+  template <std::size_t... I>
+  reference rowAt(size_type index, detail::IndexSequence<I...>)
+  {
+    return reference(std::get<I>(columns)[index]...);
+  }
+
+  template <std::size_t... I>
+  const_reference rowAt(size_type index, detail::IndexSequence<I...>) const
+  {
+    return const_reference(std::get<I>(columns)[index]...);
+  }
+
+  template <std::size_t... I>
+  value_type moveRow(size_type index, detail::IndexSequence<I...>)
+  {
+    return value_type(std::move(std::get<I>(columns)[index])...);
+  }
+
+  void reallocate()
+  {
+    size_type newReserved = reservedSize != 0 ? reservedSize * 2 : 2;
+    reallocateColumns(newReserved, Indices());
+    reservedSize = newReserved;
+  }
+
+public:
+  SoAVector()
+    : vectorSize(0), reservedSize(2)
+  {
+    allocateColumns(Indices());
+  }
+
+  SoAVector(const SoAVector& other)
+    : vectorSize(other.vectorSize), reservedSize(other.reservedSize)
+  {
+    allocateColumns(Indices());
+    copyColumns(other, Indices());
+  }
+
+  SoAVector(SoAVector&& other)
+    : vectorSize(other.vectorSize), reservedSize(other.reservedSize), columns(other.columns)
+  {
+    other.vectorSize = 0;
+    other.reservedSize = 0;
+    other.columns = std::tuple<Fields*...>();
+  }
+
+  ~SoAVector()
+  {
+    releaseColumns(Indices());
+  }
+
+  SoAVector& operator=(const SoAVector& other)
+  {
+    if(this != &other)
+    {
+      releaseColumns(Indices());
+      vectorSize = other.vectorSize;
+      reservedSize = other.reservedSize;
+      allocateColumns(Indices());
+      copyColumns(other, Indices());
+    }
+    return *this;
+  }
+
+  SoAVector& operator=(SoAVector&& other)
+  {
+    if(this != &other)
+    {
+      releaseColumns(Indices());
+      vectorSize = other.vectorSize;
+      reservedSize = other.reservedSize;
+      columns = other.columns;
+      other.vectorSize = 0;
+      other.reservedSize = 0;
+      other.columns = std::tuple<Fields*...>();
+    }
+    return *this;
+  }
+
+  bool isEmpty() const
+  {
+    return vectorSize == 0;
+  }
+
+  size_type getSize() const
+  {
+    return vectorSize;
+  }
+
+  void append(const Fields&... items)
+  {
+    if(vectorSize == reservedSize)
+      reallocate();
+    storeRow(Indices(), vectorSize, items...);
+    vectorSize++;
+  }
+
+  value_type popLast()
+  {
+    if(isEmpty())
+      throw std::out_of_range("Can't delete last element in empty vector");
+    vectorSize--;
+    return moveRow(vectorSize, Indices());
+  }
+
+  void erase(const const_iterator& possition)
+  {
+    if(isEmpty())
+      throw std::out_of_range("Can't erase element from empty vector");
+    if(possition.pointerToVector != this or possition.index >= vectorSize)
+      throw std::out_of_range("Can't erase object out of vector");
+    shiftRowsDown(possition.index, possition.index + 1, Indices());
+    vectorSize--;
+  }
+
+  void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded)
+  {
+    if(firstIncluded.pointerToVector != this or lastExcluded.pointerToVector != this or
+       firstIncluded.index > lastExcluded.index or lastExcluded.index > vectorSize)
+      throw std::out_of_range("Can't erase object out of vector");
+    shiftRowsDown(firstIncluded.index, lastExcluded.index, Indices());
+    vectorSize -= lastExcluded.index - firstIncluded.index;
+  }
+
+  reference operator[](size_type index)
+  {
+    return rowAt(index, Indices());
+  }
+
+  const_reference operator[](size_type index) const
+  {
+    return rowAt(index, Indices());
+  }
+
+  template <std::size_t Index>
+  field_type<Index>& get(size_type index)
+  {
+    return std::get<Index>(columns)[index];
+  }
+
+  template <std::size_t Index>
+  const field_type<Index>& get(size_type index) const
+  {
+    return std::get<Index>(columns)[index];
+  }
+
+  template <std::size_t Index>
+  ColumnSpan<field_type<Index>> column()
+  {
+    return ColumnSpan<field_type<Index>>(std::get<Index>(columns), vectorSize);
+  }
+
+  template <std::size_t Index>
+  ColumnSpan<const field_type<Index>> column() const
+  {
+    return ColumnSpan<const field_type<Index>>(std::get<Index>(columns), vectorSize);
+  }
+
+  iterator begin()
+  {
+    return Iterator(this, 0);
+  }
+
+  iterator end()
+  {
+    return Iterator(this, vectorSize);
+  }
+
+  const_iterator cbegin() const
+  {
+    return ConstIterator(this, 0);
+  }
+
+  const_iterator cend() const
+  {
+    return ConstIterator(this, vectorSize);
+  }
+
+  const_iterator begin() const
+  {
+    return cbegin();
+  }
+
+  const_iterator end() const
+  {
+    return cend();
+  }
+};
+
+// Row iterator; dereferencing yields a tuple of references into the columns.
+template <typename... Fields>
+class SoAVector<Fields...>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename SoAVector::value_type;
+  using difference_type = typename SoAVector::difference_type;
+  using reference = typename SoAVector::const_reference;
+
+  const SoAVector* pointerToVector;
+  size_type index;
+
+  explicit ConstIterator()
+    : pointerToVector(nullptr), index(0)
+  {}
+
+  ConstIterator(const SoAVector* other, size_type other2)
+    : pointerToVector(other), index(other2)
+  {}
+
+  reference operator*() const
+  {
+    if(pointerToVector == nullptr or pointerToVector->vectorSize <= index)
+      throw std::out_of_range("Iterator is pointing to non-existing place");
+    return (*pointerToVector)[index];
+  }
+
+  ConstIterator& operator++()
+  {
+    if(pointerToVector == nullptr or index == pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase iterator");
+    index++;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    ConstIterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  ConstIterator& operator--()
+  {
+    if(index == 0)
+      throw std::out_of_range("Can't decrease iterator");
+    index--;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    ConstIterator result(*this);
+    --(*this);
+    return result;
+  }
+
+  ConstIterator operator+(difference_type d) const
+  {
+    difference_type target = (difference_type)index + d;
+    if(pointerToVector == nullptr or target < 0 or target > (difference_type)pointerToVector->vectorSize)
+      throw std::out_of_range("Can't increase/decrease iterator");
+    return ConstIterator(pointerToVector, (size_type)target);
+  }
+
+  ConstIterator operator-(difference_type d) const
+  {
+    return operator+(-d);
+  }
+
+  bool operator==(const ConstIterator& other) const
+  {
+    return pointerToVector == other.pointerToVector and index == other.index;
+  }
+
+  bool operator!=(const ConstIterator& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+template <typename... Fields>
+class SoAVector<Fields...>::Iterator : public SoAVector<Fields...>::ConstIterator
+{
+public:
+  using reference = typename SoAVector::reference;
+
+  explicit Iterator()
+  {}
+
+  Iterator(const ConstIterator& other)
+    : ConstIterator(other)
+  {}
+
+  Iterator(const SoAVector* other, size_type other2)
+    : ConstIterator(other, other2)
+  {}
+
+  Iterator& operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator& operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const
+  {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const
+  {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const
+  {
+    ConstIterator::operator*();
+    // same trick as Vector::Iterator: the row is owned by a non-const vector.
+    return (*const_cast<SoAVector*>(this->pointerToVector))[this->index];
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_SOAVECTOR_H
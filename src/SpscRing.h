@@ -0,0 +1,144 @@
+#ifndef AISDI_LINEAR_SPSCRING_H
+#define AISDI_LINEAR_SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "CacheLine.h"
+
+namespace aisdi
+{
+
+// Fixed-capacity ring for handing items from exactly one producer thread to
+// exactly one consumer thread, without locks or allocation per item.
+// Each side owns its index on a separate cache line and keeps a cached copy
+// of the other side's index, so the shared line is read only when the cached
+// value says the ring looks full (producer) or empty (consumer).
+// Capacity is rounded up to a power of two.
+template <typename Type>
+class SpscRing
+{
+public:
+  using size_type = std::size_t;
+  using value_type = Type;
+
+private:
+  struct ConsumerSide
+  {
+    std::atomic<size_type> head;
+    size_type cachedTail;
+  };
+
+  struct ProducerSide
+  {
+    std::atomic<size_type> tail;
+    size_type cachedHead;
+  };
+
+  // head and tail only grow; the slot is the index masked by capacity - 1
+  detail::CacheLinePadded<ConsumerSide> consumer;
+  detail::CacheLinePadded<ProducerSide> producer;
+  size_type capacity;
+  size_type mask;
+  Type* elements;
+
+  static size_type roundUpToPowerOfTwo(size_type value)
+  {
+    size_type result = 1;
+    while(result < value)
+      result *= 2;
+    return result;
+  }
+
+public:
+  explicit SpscRing(size_type requestedCapacity)
+    : capacity(roundUpToPowerOfTwo(requestedCapacity)), mask(capacity - 1),
+      elements(nullptr)
+  {
+    if(requestedCapacity == 0)
+      throw std::out_of_range("Ring capacity must be positive");
+    elements = new Type[capacity];
+    consumer.value.head.store(0, std::memory_order_relaxed);
+    consumer.value.cachedTail = 0;
+    producer.value.tail.store(0, std::memory_order_relaxed);
+    producer.value.cachedHead = 0;
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  ~SpscRing()
+  {
+    delete [] elements;
+  }
+
+  size_type getCapacity() const
+  {
+    return capacity;
+  }
+
+  // Exact only when neither side is running; otherwise a snapshot.
+  size_type getSize() const
+  {
+    const size_type head = consumer.value.head.load(std::memory_order_acquire);
+    return producer.value.tail.load(std::memory_order_acquire) - head;
+  }
+
+  bool isEmpty() const
+  {
+    return getSize() == 0;
+  }
+
+  // Producer side. Pushes as many of count items as fit and returns how many
+  // it took; the whole batch becomes visible with a single store.
+  size_type tryPushN(const Type* items, size_type count)
+  {
+    ProducerSide& side = producer.value;
+    const size_type tail = side.tail.load(std::memory_order_relaxed);
+    size_type free = capacity - (tail - side.cachedHead);
+    if(free < count)
+    {
+      side.cachedHead = consumer.value.head.load(std::memory_order_acquire);
+      free = capacity - (tail - side.cachedHead);
+    }
+    const size_type pushed = count < free ? count : free;
+    for(size_type i = 0; i != pushed; i++)
+      elements[(tail + i) & mask] = items[i];
+    side.tail.store(tail + pushed, std::memory_order_release);
+    return pushed;
+  }
+
+  bool tryPush(const Type& item)
+  {
+    return tryPushN(&item, 1) == 1;
+  }
+
+  // Consumer side. Moves up to count items into out and returns how many.
+  size_type tryPopN(Type* out, size_type count)
+  {
+    ConsumerSide& side = consumer.value;
+    const size_type head = side.head.load(std::memory_order_relaxed);
+    size_type available = side.cachedTail - head;
+    if(available < count)
+    {
+      side.cachedTail = producer.value.tail.load(std::memory_order_acquire);
+      available = side.cachedTail - head;
+    }
+    const size_type popped = count < available ? count : available;
+    for(size_type i = 0; i != popped; i++)
+      out[i] = std::move(elements[(head + i) & mask]);
+    side.head.store(head + popped, std::memory_order_release);
+    return popped;
+  }
+
+  bool tryPop(Type& item)
+  {
+    return tryPopN(&item, 1) == 1;
+  }
+};
+
+}
+
+#endif // AISDI_LINEAR_SPSCRING_H
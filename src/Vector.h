@@ -4,12 +4,20 @@
 #include <cstddef>
 #include <initializer_list>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "ContainerStats.h"
+#include "VectorFile.h"
 
 namespace aisdi
 {
 
-template <typename Type>
-class Vector
+// Stats is the statistics policy (see ContainerStats.h); the default
+// NoContainerStats compiles the counting out.
+template <typename Type, typename Stats = DefaultContainerStats>
+class Vector : private Stats
 {
 public:
   using difference_type = std::ptrdiff_t;
@@ -35,12 +43,14 @@ public:
     vectorSize = 0;
     reservedSize = 2;
     vectorArray = new value_type[reservedSize];
+    track();
   }
   Vector(std::initializer_list<Type> l)
   {
     vectorSize = 0;
-    reservedSize = l.size() + 1;
+    reservedSize = l.size() != 0 ? l.size() : 2;
     vectorArray = new value_type[reservedSize];
+    track();
     for(auto i = l.begin(); i != l.end(); i++)
     {
       append(*i);
@@ -48,11 +58,13 @@ public:
   }
 
   Vector(const Vector& other)
+    : Stats()
   {
       vectorSize = other.vectorSize;
       reservedSize = other.reservedSize;
       vectorArray = new value_type[reservedSize];
-      for(auto i = 0; i != vectorSize; i++)
+      track();
+      for(size_type i = 0; i != vectorSize; i++)
       {
           vectorArray[i] = other.vectorArray[i];
       }
@@ -66,6 +78,7 @@ public:
       other.vectorSize = 0;
       other.reservedSize = 0;
       other.vectorArray = nullptr;
+      track();
   }
 
   ~Vector()
@@ -78,11 +91,16 @@ public:
   Vector& operator=(const Vector& other)
   {
       if(this != &other) {
-          delete [] vectorArray;
+          // keep our storage when it is big enough, so reused vectors don't reallocate
+          if(reservedSize < other.vectorSize)
+          {
+              delete [] vectorArray;
+              reservedSize = other.reservedSize;
+              vectorArray = new value_type[reservedSize];
+              Stats::onCapacity(reservedSize);
+          }
           vectorSize = other.vectorSize;
-          reservedSize = other.reservedSize;
-          vectorArray = new value_type[reservedSize];
-          for (auto i = 0; i != vectorSize; i++)
+          for (size_type i = 0; i != vectorSize; i++)
           {
               vectorArray[i] = other.vectorArray[i];
           }
@@ -101,10 +119,17 @@ public:
           other.vectorSize = 0;
           other.reservedSize = 0;
           other.vectorArray = nullptr;
+          Stats::onCapacity(reservedSize);
       }
       return *this;
   }
 
+  // An empty vector that holds capacity elements before it reallocates.
+  static Vector withCapacity(size_type capacity)
+  {
+      return Vector(CapacityTag(), capacity);
+  }
+
   bool isEmpty() const
   {
     if(vectorSize==0)
@@ -130,6 +155,7 @@ public:
   {
     if(vectorSize==reservedSize)
       reallocate();
+    Stats::onElementsMoved(vectorSize);
     for(auto i=vectorSize; i!=0; i--)
     {
       vectorArray[i]=vectorArray[i-1];
@@ -153,6 +179,7 @@ public:
     if(vectorSize==reservedSize)
       reallocate();
     size_type insertPlace=insertPosition.index-cbegin().index;
+    Stats::onElementsMoved(vectorSize - insertPlace);
     for(auto i=vectorSize; i!=insertPlace; i--)
     {
       vectorArray[i]=vectorArray[i-1];
@@ -168,7 +195,8 @@ public:
     else
     {
         value_type temporary = *begin();
-        for(auto i = 0; i != vectorSize - 1; i++)
+        Stats::onElementsMoved(vectorSize - 1);
+        for(size_type i = 0; i != vectorSize - 1; i++)
         {
             vectorArray[i] = vectorArray[i+1];
         }
@@ -195,6 +223,7 @@ public:
           throw std::out_of_range("Can't erase element from empty vector");
       if (possition.index >= vectorSize or possition.index < 0)
           throw std::out_of_range("Can't erase object out of vector");
+      Stats::onElementsMoved(vectorSize - 1 - possition.index);
       for(auto i = possition.index; i != vectorSize -1; i++)
       {
           vectorArray[i] = vectorArray[i+1];
@@ -210,6 +239,7 @@ public:
           throw std::out_of_range("Can't erase object out of vector");
       if (lastExcluded.index >= cend().index and lastExcluded.index < cbegin().index)
           throw std::out_of_range("Can't erase object out of vector");
+      Stats::onElementsMoved(vectorSize - lastExcluded.index);
       for(auto i = lastExcluded.index; i != vectorSize; i++)
       {
           vectorArray[i - lastExcluded.index + firstIncluded.index] = vectorArray[i];
@@ -217,6 +247,92 @@ public:
       vectorSize -= lastExcluded.index - firstIncluded.index;
   }
 
+  size_type getCapacity() const
+  {
+    return reservedSize;
+  }
+
+  // Grows storage to hold at least capacity elements without reallocating.
+  void reserve(size_type capacity)
+  {
+      if(capacity <= reservedSize or capacity < vectorSize)
+          return;
+      auto newArray = new value_type[capacity];
+      Stats::onReallocation(vectorSize, capacity);
+      for (size_type i = 0; i != vectorSize; i++)
+      {
+          newArray[i] = std::move(vectorArray[i]);
+      }
+      delete [] vectorArray;
+      vectorArray = newArray;
+      reservedSize = capacity;
+  }
+
+  pointer data()
+  {
+    return vectorArray;
+  }
+
+  const_pointer data() const
+  {
+    return vectorArray;
+  }
+
+  // Removes every element matching predicate in a single stable pass:
+  // survivors are moved down once instead of shifting the tail per erase.
+  template <typename Predicate>
+  size_type removeIf(Predicate predicate)
+  {
+      size_type kept = 0;
+      for(size_type i = 0; i != vectorSize; i++)
+      {
+          if(predicate(vectorArray[i]))
+              continue;
+          if(kept != i)
+          {
+              vectorArray[kept] = std::move(vectorArray[i]);
+              Stats::onElementsMoved(1);
+          }
+          kept++;
+      }
+      size_type removed = vectorSize - kept;
+      vectorSize = kept;
+      return removed;
+  }
+
+  // O(1) erase that fills the hole with the last element; doesn't keep order.
+  void swapErase(const const_iterator& possition)
+  {
+      if (isEmpty() == 1)
+          throw std::out_of_range("Can't erase element from empty vector");
+      if (possition.index >= vectorSize)
+          throw std::out_of_range("Can't erase object out of vector");
+      if (possition.index != vectorSize - 1)
+      {
+          vectorArray[possition.index] = std::move(vectorArray[vectorSize - 1]);
+          Stats::onElementsMoved(1);
+      }
+      vectorSize--;
+  }
+
+  // The policy's counters plus the current unused capacity in bytes.
+  ContainerStats stats() const
+  {
+      ContainerStats result = Stats::counters();
+      result.wastedBytes = (reservedSize - vectorSize) * sizeof(Type);
+      return result;
+  }
+
+  // Writes a binary image (see VectorFile.h) that MappedVector can map back
+  // without parsing or copying. Only for trivially copyable element types.
+  void saveTo(const std::string& path) const
+  {
+      static_assert(std::is_trivially_copyable<Type>::value,
+                    "Vector::saveTo requires a trivially copyable element type");
+      detail::writeVectorFile(path, detail::makeVectorFileHeader<Type>(vectorSize),
+                              vectorArray, vectorSize * sizeof(Type));
+  }
+
   iterator begin()
   {
       iterator i = Iterator(this,0);
@@ -250,11 +366,38 @@ public:
   {
     return cend();
   }
+
+protected:
+  struct CapacityTag
+  {};
+
+  Vector(CapacityTag, size_type capacity)
+  {
+    vectorSize = 0;
+    reservedSize = capacity != 0 ? capacity : 2;
+    vectorArray = new value_type[reservedSize];
+    track();
+  }
+
+private:
+  static ContainerStats statsOf(const void* owner)
+  {
+      return static_cast<const Vector*>(owner)->stats();
+  }
+
+  void track()
+  {
+      Stats::trackContainer("Vector", this, &Vector::statsOf);
+      Stats::onCapacity(reservedSize);
+  }
+
+public:
   void reallocate()
   {
-      reservedSize*=2;
+      reservedSize = reservedSize != 0 ? reservedSize * 2 : 2;
       auto newArray = new value_type[reservedSize];
-      for (auto i = 0; i != vectorSize; i++)
+      Stats::onReallocation(vectorSize, reservedSize);
+      for (size_type i = 0; i != vectorSize; i++)
       {
           newArray[i] = vectorArray[i];
       }
@@ -263,8 +406,8 @@ public:
   }
 };
 
-template <typename Type>
-class Vector<Type>::ConstIterator
+template <typename Type, typename Stats>
+class Vector<Type, Stats>::ConstIterator
 {
 public:
   using iterator_category = std::bidirectional_iterator_tag;
@@ -331,7 +474,7 @@ public:
 
   ConstIterator operator+(difference_type d) const
   {
-      if (index + d > pointerToVector->vectorSize or index + d < 0)
+      if ((difference_type)index + d > (difference_type)pointerToVector->vectorSize or (difference_type)index + d < 0)
           throw std::out_of_range("Can't increase/decrease iterator");
       ConstIterator i(pointerToVector, index + d);
       return i;
@@ -359,8 +502,8 @@ public:
   }
 };
 
-template <typename Type>
-class Vector<Type>::Iterator : public Vector<Type>::ConstIterator
+template <typename Type, typename Stats>
+class Vector<Type, Stats>::Iterator : public Vector<Type, Stats>::ConstIterator
 {
 public:
   using pointer = typename Vector::pointer;
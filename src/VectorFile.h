@@ -0,0 +1,105 @@
+#ifndef AISDI_LINEAR_VECTORFILE_H
+#define AISDI_LINEAR_VECTORFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// On-disk layout written by Vector::saveTo and read by MappedVector:
+// a fixed header padded to vectorFileDataOffset bytes, then the raw elements.
+// The padding keeps the payload aligned for any element type up to 64 bytes
+// alignment once the file is mapped at a page boundary.
+struct VectorFileHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t elementSize;
+  std::uint32_t elementAlignment;
+  std::uint32_t reserved;
+  std::uint64_t typeFingerprint;
+  std::uint64_t elementCount;
+};
+
+const char vectorFileMagic[8] = { 'A', 'I', 'S', 'D', 'I', 'V', 'E', 'C' };
+const std::uint32_t vectorFileVersion = 1;
+const std::size_t vectorFileDataOffset = 64;
+
+static_assert(sizeof(VectorFileHeader) <= vectorFileDataOffset, "Vector file header doesn't fit");
+
+// FNV-1a of the compiler's type name mixed with size and alignment. It catches
+// loading a file as the wrong element type; the name is only stable for one
+// compiler ABI, which is fine for files written and read by the same build.
+template <typename Type>
+std::uint64_t typeFingerprint()
+{
+  std::uint64_t hash = 14695981039346656037ull;
+  for(const char* c = typeid(Type).name(); *c != '\0'; c++)
+  {
+    hash ^= (unsigned char)*c;
+    hash *= 1099511628211ull;
+  }
+  hash ^= sizeof(Type) * 31 + alignof(Type);
+  return hash * 1099511628211ull;
+}
+
+template <typename Type>
+VectorFileHeader makeVectorFileHeader(std::size_t count)
+{
+  static_assert(alignof(Type) <= vectorFileDataOffset, "Element alignment too large for vector file");
+  VectorFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, vectorFileMagic, sizeof(header.magic));
+  header.version = vectorFileVersion;
+  header.elementSize = sizeof(Type);
+  header.elementAlignment = alignof(Type);
+  header.typeFingerprint = typeFingerprint<Type>();
+  header.elementCount = count;
+  return header;
+}
+
+// Throws std::runtime_error describing why the header doesn't describe Type.
+template <typename Type>
+void checkVectorFileHeader(const VectorFileHeader& header, std::size_t fileSize,
+                           const std::string& path)
+{
+  if(std::memcmp(header.magic, vectorFileMagic, sizeof(header.magic)) != 0)
+    throw std::runtime_error(path + " is not a vector file");
+  if(header.version != vectorFileVersion)
+    throw std::runtime_error(path + " has unsupported vector file version");
+  if(header.elementSize != sizeof(Type) or header.elementAlignment != alignof(Type) or
+     header.typeFingerprint != typeFingerprint<Type>())
+    throw std::runtime_error(path + " holds elements of a different type");
+  if((fileSize - vectorFileDataOffset) / sizeof(Type) < header.elementCount)
+    throw std::runtime_error(path + " is truncated");
+}
+
+inline void writeVectorFile(const std::string& path, const VectorFileHeader& header,
+                            const void* data, std::size_t bytes)
+{
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if(file == nullptr)
+    throw std::runtime_error("Can't open " + path + " for writing");
+  const char padding[vectorFileDataOffset] = {};
+  bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 and
+                 std::fwrite(padding, vectorFileDataOffset - sizeof(header), 1, file) == 1 and
+                 (bytes == 0 or std::fwrite(data, bytes, 1, file) == 1);
+  written = std::fclose(file) == 0 and written;
+  if(!written)
+    throw std::runtime_error("Can't write " + path);
+}
+
+}
+
+}
+
+#endif // AISDI_LINEAR_VECTORFILE_H
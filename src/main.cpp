@@ -1,140 +1,1217 @@
 #include <cstddef>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <chrono>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include <pthread.h>
+#include <unistd.h>
 
 #include "Vector.h"
 #include "LinkedList.h"
+#include "PersistentVector.h"
+#include "SoAVector.h"
+#include "PackedVector.h"
+#include "CompressedVector.h"
+#include "MappedVector.h"
+#include "FlatMap.h"
+#include "ConcurrentAppendVector.h"
+#include "SpscRing.h"
+#include "MpmcQueue.h"
+#include "ConcurrentLinkedQueue.h"
+#include "ConcurrentOrderedList.h"
+#include "RcuVector.h"
+#include "BitVector.h"
+#include "CapacityHints.h"
+
+#include "AllocationCounter.h"
 
 namespace
 {
 
-template <typename T>
-using LinearCollection = aisdi::LinkedList<T>;
-
-void perfomTest(size_t amount)
+void perfomPersistentTest(size_t amount)
 {
-    /*LinearCollection<std::string> collection;
-    collection.append("TODO");*/
     using namespace std::chrono;
-    if(amount > 100000000) amount = 100000000;
-    else if(amount < 10) amount = 10;
+    const size_t versions = 100;
 
-    aisdi::LinkedList<std::string> list;
-    aisdi::Vector<std::string> vector;
-
-    std::string element  = "testujemy";
-
-    //appending
+    // building the first version
     high_resolution_clock::time_point t1 = high_resolution_clock::now();
-    for(size_t count = 0; count <= amount; count++)
-    {
-        vector.append(element);
-    }
+    aisdi::Vector<int> vector;
+    for(size_t count = 0; count != amount; count++)
+        vector.append((int)count);
     high_resolution_clock::time_point t2 = high_resolution_clock::now();
 
-    auto vector_time = duration_cast<milliseconds>( t2 - t1 ).count();
+    auto vector_time = duration_cast<microseconds>( t2 - t1 ).count();
 
     high_resolution_clock::time_point t3 = high_resolution_clock::now();
-    for(size_t count = 0; count <= amount; count++)
-    {
-        list.append(element);
-    }
+    auto builder = aisdi::PersistentVector<int>().transient();
+    for(size_t count = 0; count != amount; count++)
+        builder.append((int)count);
+    aisdi::PersistentVector<int> persistent = builder.persistent();
     high_resolution_clock::time_point t4 = high_resolution_clock::now();
 
-    auto list_time = duration_cast<milliseconds>( t4 - t3 ).count();
+    auto persistent_time = duration_cast<microseconds>( t4 - t3 ).count();
 
-    std::cout<<"Appending "<<amount<<" elements took"<<std::endl<<
+    std::cout<<"Building "<<amount<<" elements took [us]"<<std::endl<<
              vector_time<<" in vector"<<std::endl<<
-             list_time<<" in list"<<std::endl;
+             persistent_time<<" in persistent vector (transient)"<<std::endl;
 
-    //inserting at possition begin +2
+    //keeping versions, each with one element changed
+    aisdi::Vector<aisdi::Vector<int>> vectorVersions;
+    aisdi::bench::AllocationCounter vector_heap;
     t1 = high_resolution_clock::now();
-    vector.insert(vector.begin()+2, element);
+    for(size_t count = 0; count != versions; count++)
+    {
+        aisdi::Vector<int> copy(vector);
+        *(copy.begin() + (count * 7919) % amount) = -1;
+        vectorVersions.append(copy);
+    }
     t2 = high_resolution_clock::now();
+    const aisdi::bench::AllocationCounts vector_counts = vector_heap.stop();
 
-    vector_time = duration_cast<milliseconds>( t2 - t1 ).count();
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
 
+    aisdi::Vector<aisdi::PersistentVector<int>> persistentVersions;
+    aisdi::bench::AllocationCounter persistent_heap;
     t3 = high_resolution_clock::now();
-    list.insert(list.begin()+2, element);
+    for(size_t count = 0; count != versions; count++)
+        persistentVersions.append(persistent.set((count * 7919) % amount, -1));
     t4 = high_resolution_clock::now();
+    const aisdi::bench::AllocationCounts persistent_counts = persistent_heap.stop();
 
-    list_time = duration_cast<milliseconds>( t4 - t3 ).count();
+    persistent_time = duration_cast<microseconds>( t4 - t3 ).count();
 
-    std::cout<<"Inserting 2 positions after begin took"<<std::endl<<
-             vector_time<<" in vector"<<std::endl<<
-             list_time<<" in list"<<std::endl;
+    // heap bytes the versions still hold, including the list keeping them
+    const long long vector_bytes = vector_counts.liveBytes / (long long)versions;
+    const long long persistent_bytes = persistent_counts.liveBytes / (long long)versions;
+
+    std::cout<<"Creating "<<versions<<" changed versions took [us]"<<std::endl<<
+             vector_time<<" in vector ("<<vector_bytes<<" B per version)"<<std::endl<<
+             persistent_time<<" in persistent vector ("<<persistent_bytes<<" B per version)"<<std::endl;
 
-    //inserting at possition end -2
+    //reading every element
+    long long checksum = 0;
     t1 = high_resolution_clock::now();
-    vector.insert(vector.end()-2, element);
+    for(auto i = vector.cbegin(); i != vector.cend(); i++)
+        checksum += *i;
     t2 = high_resolution_clock::now();
 
-    vector_time = duration_cast<milliseconds>( t2 - t1 ).count();
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
 
     t3 = high_resolution_clock::now();
-    list.insert(list.end()-2, element);
+    for(auto i = persistent.cbegin(); i != persistent.cend(); i++)
+        checksum -= *i;
     t4 = high_resolution_clock::now();
 
-    list_time = duration_cast<milliseconds>( t4 - t3 ).count();
+    persistent_time = duration_cast<microseconds>( t4 - t3 ).count();
 
-    std::cout<<"Inserting 2 positions before end took"<<std::endl<<
+    std::cout<<"Iterating over "<<amount<<" elements took [us] (checksum "<<checksum<<")"<<std::endl<<
              vector_time<<" in vector"<<std::endl<<
-             list_time<<" in list"<<std::endl;
+             persistent_time<<" in persistent vector"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+struct Record
+{
+    double price;
+    int quantity;
+    int id;
+    std::array<char, 48> name;
+};
+
+void perfomSoATest(size_t amount)
+{
+    using namespace std::chrono;
+    const size_t repeats = 20;
+
+    aisdi::Vector<Record> records;
+    aisdi::SoAVector<double, int, int, std::array<char, 48>> columns;
+    for(size_t count = 0; count != amount; count++)
+    {
+        Record record = { count * 0.5, (int)count, (int)count, {} };
+        records.append(record);
+        columns.append(record.price, record.quantity, record.id, record.name);
+    }
+
+    //summing a single field
+    double vector_sum = 0;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+        for(auto i = records.cbegin(); i != records.cend(); i++)
+            vector_sum += (*i).price;
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    double soa_sum = 0;
+    high_resolution_clock::time_point t3 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        auto prices = columns.column<0>();
+        for(auto i = prices.begin(); i != prices.end(); i++)
+            soa_sum += *i;
+    }
+    high_resolution_clock::time_point t4 = high_resolution_clock::now();
+
+    auto soa_time = duration_cast<microseconds>( t4 - t3 ).count();
 
-    //erasing
+    std::cout<<"Summing one field of "<<amount<<" records "<<repeats<<" times took [us]"<<std::endl<<
+             vector_time<<" in vector of structs (sum "<<vector_sum<<")"<<std::endl<<
+             soa_time<<" in struct of arrays (sum "<<soa_sum<<")"<<std::endl;
+
+    //summing two fields
+    long long vector_total = 0;
     t1 = high_resolution_clock::now();
-    vector.erase(vector.begin(), vector.end());
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+        for(auto i = records.cbegin(); i != records.cend(); i++)
+            vector_total += (*i).quantity * (long long)(*i).id;
     t2 = high_resolution_clock::now();
 
-    vector_time = duration_cast<milliseconds>( t2 - t1 ).count();
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
 
+    long long soa_total = 0;
     t3 = high_resolution_clock::now();
-    list.erase(list.begin(),list.end());
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        auto quantities = columns.column<1>();
+        auto ids = columns.column<2>();
+        for(size_t i = 0; i != quantities.getSize(); i++)
+            soa_total += quantities[i] * (long long)ids[i];
+    }
     t4 = high_resolution_clock::now();
 
-    list_time = duration_cast<milliseconds>( t4 - t3 ).count();
+    soa_time = duration_cast<microseconds>( t4 - t3 ).count();
+
+    std::cout<<"Combining two fields of "<<amount<<" records "<<repeats<<" times took [us]"<<std::endl<<
+             vector_time<<" in vector of structs (total "<<vector_total<<")"<<std::endl<<
+             soa_time<<" in struct of arrays (total "<<soa_total<<")"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomCompressedTest(size_t amount)
+{
+    using namespace std::chrono;
+    const size_t repeats = 20;
+
+    // near-sorted 20-bit ids
+    aisdi::Vector<std::uint64_t> vector;
+    aisdi::PackedVector<20> packed;
+    aisdi::CompressedVector compressed;
+    for(size_t count = 0; count != amount; count++)
+    {
+        std::uint64_t id = (count * 3 + (count % 5)) & 0xFFFFF;
+        vector.append(id);
+        packed.append(id);
+        compressed.append(id);
+    }
+    aisdi::Vector<std::uint64_t> decoded;
+    for(size_t count = 0; count != amount; count++)
+        decoded.append(0);
+    std::uint64_t* out = &*decoded.begin();
+
+    //sequential decode
+    std::uint64_t vector_sum = 0;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+        for(auto i = vector.cbegin(); i != vector.cend(); i++)
+            vector_sum += *i;
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::uint64_t packed_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        packed.unpack(out);
+        for(size_t i = 0; i != amount; i++)
+            packed_sum += out[i];
+    }
+    t2 = high_resolution_clock::now();
+
+    auto packed_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::uint64_t compressed_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        compressed.decode(out);
+        for(size_t i = 0; i != amount; i++)
+            compressed_sum += out[i];
+    }
+    t2 = high_resolution_clock::now();
+
+    auto compressed_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    // bytes per element use the allocated storage
+    const size_t vector_bytes = vector.getCapacity() * sizeof(std::uint64_t);
+    const double total = (double)amount * repeats;
+
+    std::cout<<"Decoding "<<amount<<" ids "<<repeats<<" times"<<std::endl<<
+             "vector:     "<<(double)vector_bytes / amount<<" B/element, "<<
+             total / (vector_time + 1)<<" Melements/s (sum "<<vector_sum<<")"<<std::endl<<
+             "packed:     "<<(double)packed.getBytes() / amount<<" B/element, "<<
+             total / (packed_time + 1)<<" Melements/s (sum "<<packed_sum<<")"<<std::endl<<
+             "compressed: "<<(double)compressed.getBytes() / amount<<" B/element, "<<
+             total / (compressed_time + 1)<<" Melements/s (sum "<<compressed_sum<<")"<<std::endl;
+
+    //block kernels alone, on the packed words of every full block
+    const aisdi::detail::BlockKernels& kernels = aisdi::detail::BlockKernels::instance();
+    const size_t blocks = amount / 64;
+    aisdi::Vector<std::uint64_t> blockWords;
+    for(size_t count = 0; count != blocks * 20; count++)
+        blockWords.append(0);
+    std::uint64_t* words = &*blockWords.begin();
+    for(size_t block = 0; block != blocks; block++)
+        kernels.pack[20](out + block * 64, words + block * 20);
+
+    std::uint64_t scalar_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+        for(size_t block = 0; block != blocks; block++)
+        {
+            kernels.scalarUnpack[20](words + block * 20, out + block * 64);
+            scalar_sum += out[block * 64];
+        }
+    t2 = high_resolution_clock::now();
+
+    auto scalar_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::uint64_t simd_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+        for(size_t block = 0; block != blocks; block++)
+        {
+            kernels.unpack[20](words + block * 20, out + block * 64);
+            simd_sum += out[block * 64];
+        }
+    t2 = high_resolution_clock::now();
+
+    auto simd_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    const double kernel_total = (double)blocks * 64 * repeats;
+    std::cout<<"Unpacking "<<blocks<<" blocks of 20-bit values "<<repeats<<" times"<<std::endl<<
+             "scalar kernel: "<<kernel_total / (scalar_time + 1)<<" Melements/s (sum "<<scalar_sum<<")"<<std::endl<<
+             kernels.unpackName<<" kernel: "<<kernel_total / (simd_time + 1)<<" Melements/s (sum "<<simd_sum<<")"<<std::endl;
+
+    //random access
+    vector_sum = packed_sum = compressed_sum = 0;
+    const size_t lookups = 10000;
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        vector_sum += *(vector.cbegin() + (count * 7919) % amount);
+    t2 = high_resolution_clock::now();
 
-    std::cout<<"Erasing from begin to end took"<<std::endl<<
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        packed_sum += packed[(count * 7919) % amount];
+    t2 = high_resolution_clock::now();
+
+    packed_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        compressed_sum += compressed.at((count * 7919) % amount);
+    t2 = high_resolution_clock::now();
+
+    compressed_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<lookups<<" random lookups took [us]"<<std::endl<<
              vector_time<<" in vector"<<std::endl<<
-             list_time<<" in list"<<std::endl;
+             packed_time<<" in packed vector"<<std::endl<<
+             compressed_time<<" in compressed vector"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
 
-    //prepending
-    amount /= 10;
+// A fresh directory under $TMPDIR (or /tmp) for files a test writes; the
+// files and the directory go away when it does, also when the test throws.
+struct ScratchDirectory
+{
+    std::string path;
+    aisdi::Vector<std::string> files;
+
+    ScratchDirectory()
+    {
+        const char* tmpdir = std::getenv("TMPDIR");
+        std::string name = std::string(tmpdir != nullptr and *tmpdir != '\0' ? tmpdir : "/tmp") +
+                           "/aisdi_bench_XXXXXX";
+        if(mkdtemp(&name[0]) == nullptr)
+            throw std::runtime_error("Cannot create a directory like " + name);
+        path = name;
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    ~ScratchDirectory()
+    {
+        for(const std::string& file : files)
+            std::remove(file.c_str());
+        rmdir(path.c_str());
+    }
+
+    std::string file(const std::string& name)
+    {
+        const std::string file = path + "/" + name;
+        files.append(file);
+        return file;
+    }
+};
+
+void perfomMappedTest(size_t amount)
+{
+    using namespace std::chrono;
+    ScratchDirectory directory;
+    const std::string textPath = directory.file("vector.txt");
+    const std::string binaryPath = directory.file("vector.bin");
+
+    aisdi::Vector<std::uint64_t> vector;
+    for(size_t count = 0; count != amount; count++)
+        vector.append(count * 2654435761u);
+
+    //saving
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    {
+        std::ofstream text(textPath);
+        for(auto i = vector.cbegin(); i != vector.cend(); i++)
+            text<<*i<<'\n';
+    }
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto text_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    high_resolution_clock::time_point t3 = high_resolution_clock::now();
+    vector.saveTo(binaryPath);
+    high_resolution_clock::time_point t4 = high_resolution_clock::now();
+
+    auto binary_time = duration_cast<microseconds>( t4 - t3 ).count();
+
+    std::cout<<"Saving "<<amount<<" elements took [us]"<<std::endl<<
+             text_time<<" as text"<<std::endl<<
+             binary_time<<" as binary"<<std::endl;
+
+    //loading and summing once (what a restart does)
+    std::uint64_t text_sum = 0;
     t1 = high_resolution_clock::now();
-    for(size_t count = 0; count <= amount; count++)
     {
-        vector.prepend(element);
+        aisdi::Vector<std::uint64_t> loaded;
+        std::ifstream text(textPath);
+        std::uint64_t value;
+        while(text>>value)
+            loaded.append(value);
+        for(auto i = loaded.cbegin(); i != loaded.cend(); i++)
+            text_sum += *i;
     }
     t2 = high_resolution_clock::now();
 
-    vector_time = duration_cast<milliseconds>( t2 - t1 ).count();
+    text_time = duration_cast<microseconds>( t2 - t1 ).count();
 
+    std::uint64_t mapped_sum = 0;
     t3 = high_resolution_clock::now();
-    for(size_t count = 0; count <= amount; count++)
+    aisdi::MappedVector<std::uint64_t> mapped(binaryPath);
+    high_resolution_clock::time_point opened = high_resolution_clock::now();
+    for(auto i = mapped.cbegin(); i != mapped.cend(); i++)
+        mapped_sum += *i;
+    t4 = high_resolution_clock::now();
+
+    binary_time = duration_cast<microseconds>( t4 - t3 ).count();
+    auto open_time = duration_cast<microseconds>( opened - t3 ).count();
+
+    std::cout<<"Loading and summing "<<amount<<" elements took [us]"<<std::endl<<
+             text_time<<" parsing text (sum "<<text_sum<<")"<<std::endl<<
+             binary_time<<" mapping binary, "<<open_time<<" of it opening (sum "<<mapped_sum<<")"<<
+             std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomRemoveIfTest(size_t amount)
+{
+    using namespace std::chrono;
+
+    aisdi::Vector<int> erased;
+    aisdi::Vector<int> compacted;
+    aisdi::LinkedList<int> list;
+    for(size_t count = 0; count != amount; count++)
     {
-        list.prepend(element);
+        erased.append((int)count);
+        compacted.append((int)count);
+        list.append((int)count);
     }
-    t4 = high_resolution_clock::now();
+    auto everyThird = [](int item) { return item % 3 == 0; };
+
+    //removing every third element; repeated erase is quadratic, so it is skipped for big sizes
+    const bool runErase = amount <= 100000;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(auto i = erased.begin(); runErase and i != erased.end();)
+    {
+        if(everyThird(*i))
+            erased.erase(i);
+        else
+            i++;
+    }
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
 
-    list_time = duration_cast<milliseconds>( t4 - t3 ).count();
+    auto erase_time = duration_cast<microseconds>( t2 - t1 ).count();
 
-    std::cout<<"Prepending "<<amount<<" elements took"<<std::endl<<
-             vector_time<<" in vector"<<std::endl<<
-             list_time<<" in list"<<std::endl<<std::endl<<std::endl<<std::endl;
+    t1 = high_resolution_clock::now();
+    compacted.removeIf(everyThird);
+    t2 = high_resolution_clock::now();
+
+    auto vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    list.removeIf(everyThird);
+    t2 = high_resolution_clock::now();
+
+    auto list_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Removing every third of "<<amount<<" elements took [us]"<<std::endl<<
+             (runErase ? std::to_string(erase_time) : "(skipped)")<<" in vector with repeated erase"<<std::endl<<
+             vector_time<<" in vector with removeIf"<<std::endl<<
+             list_time<<" in list with removeIf"<<std::endl;
+
+    //removing from the front without keeping order
+    const size_t removals = compacted.getSize() / 2;
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != removals; count++)
+        compacted.swapErase(compacted.begin());
+    t2 = high_resolution_clock::now();
+
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Swap-erasing "<<removals<<" elements from the front took [us]"<<std::endl<<
+             vector_time<<" in vector"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomFlatMapTest(size_t amount)
+{
+    using namespace std::chrono;
+
+    aisdi::Vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+    for(size_t count = 0; count != amount; count++)
+        pairs.append(std::make_pair((count * 2654435761u) % (4 * amount), (std::uint64_t)count));
+
+    //building
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    std::map<std::uint64_t, std::uint64_t> map;
+    for(auto i = pairs.cbegin(); i != pairs.cend(); i++)
+        map.insert(*i);
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto map_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    aisdi::FlatMap<std::uint64_t, std::uint64_t> flat;
+    flat.insertBulk(pairs.data(), pairs.data() + pairs.getSize());
+    t2 = high_resolution_clock::now();
+
+    auto flat_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    aisdi::FlatMap<std::uint64_t, std::uint64_t> eytzinger;
+    eytzinger.insertBulk(pairs.data(), pairs.data() + pairs.getSize());
+    eytzinger.useEytzingerLayout(true);
+    t2 = high_resolution_clock::now();
+
+    auto eytzinger_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Building from "<<amount<<" keys took [us]"<<std::endl<<
+             map_time<<" in std::map"<<std::endl<<
+             flat_time<<" in flat map"<<std::endl<<
+             eytzinger_time<<" in flat map with Eytzinger layout"<<std::endl;
+
+    //looking up, keys drawn from four times the key range
+    const size_t lookups = 1000000;
+    std::uint64_t map_hits = 0, flat_hits = 0, eytzinger_hits = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        map_hits += map.count((count * 40503u) % (4 * amount));
+    t2 = high_resolution_clock::now();
+
+    map_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        flat_hits += flat.contains((count * 40503u) % (4 * amount));
+    t2 = high_resolution_clock::now();
+
+    flat_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != lookups; count++)
+        eytzinger_hits += eytzinger.contains((count * 40503u) % (4 * amount));
+    t2 = high_resolution_clock::now();
+
+    eytzinger_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<lookups<<" lookups took [us] (hits "<<map_hits<<"/"<<flat_hits<<"/"<<eytzinger_hits<<")"<<std::endl<<
+             map_time<<" in std::map"<<std::endl<<
+             flat_time<<" in flat map"<<std::endl<<
+             eytzinger_time<<" in flat map with Eytzinger layout"<<std::endl;
+
+    //iterating over values in key order
+    std::uint64_t map_sum = 0, flat_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(auto i = map.cbegin(); i != map.cend(); i++)
+        map_sum += i->second;
+    t2 = high_resolution_clock::now();
+
+    map_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    t1 = high_resolution_clock::now();
+    const std::uint64_t* values = flat.values().data();
+    for(size_t i = 0; i != flat.getSize(); i++)
+        flat_sum += values[i];
+    t2 = high_resolution_clock::now();
+
+    flat_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Iterating over "<<map.size()<<" entries took [us] (sum "<<map_sum<<"/"<<flat_sum<<")"<<std::endl<<
+             map_time<<" in std::map"<<std::endl<<
+             flat_time<<" in flat map"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+// 1, 2, 4... up to the number of hardware threads (at least 4, to show contention).
+aisdi::Vector<size_t> threadCounts()
+{
+    size_t hardware = std::thread::hardware_concurrency();
+    if(hardware < 4)
+        hardware = 4;
+    aisdi::Vector<size_t> counts;
+    for(size_t threads = 1; threads <= hardware; threads *= 2)
+        counts.append(threads);
+    return counts;
+}
+
+// Runs body(threadIndex) on threads threads and returns the wall time in microseconds.
+template <typename Body>
+long long runOnThreads(size_t threads, Body body)
+{
+    using namespace std::chrono;
+    std::vector<std::thread> workers;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(size_t thread = 0; thread != threads; thread++)
+        workers.emplace_back(body, thread);
+    for(auto& worker : workers)
+        worker.join();
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+    return duration_cast<microseconds>( t2 - t1 ).count();
+}
+
+void perfomConcurrentAppendTest(size_t amount)
+{
+    auto counts = threadCounts();
+    std::cout<<"Appending "<<amount<<" elements in total, throughput [Mappends/s]"<<std::endl;
+    for(auto threads = counts.cbegin(); threads != counts.cend(); threads++)
+    {
+        const size_t perThread = amount / *threads;
+
+        std::mutex mutex;
+        aisdi::Vector<int> vector;
+        auto vector_time = runOnThreads(*threads, [&](size_t)
+        {
+            for(size_t count = 0; count != perThread; count++)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                vector.append((int)count);
+            }
+        });
+
+        aisdi::ConcurrentAppendVector<int> concurrent;
+        auto concurrent_time = runOnThreads(*threads, [&](size_t)
+        {
+            for(size_t count = 0; count != perThread; count++)
+                concurrent.append((int)count);
+        });
+
+        const double total = (double)perThread * *threads;
+        std::cout<<*threads<<" threads: "<<
+                 total / (vector_time + 1)<<" with mutex and vector, "<<
+                 total / (concurrent_time + 1)<<" with concurrent append vector"<<std::endl;
+    }
+    std::cout<<std::endl<<std::endl<<std::endl;
+}
+
+// Moves amount ints from producers to as many consumers through a queue:
+// threads [0, pairs) push, threads [pairs, 2 * pairs) pop. push(item) and
+// pop(item) are expected to return false instead of blocking.
+template <typename Push, typename Pop>
+long long transferOnThreads(size_t pairs, size_t amount, Push push, Pop pop)
+{
+    const size_t perThread = amount / pairs;
+    return runOnThreads(2 * pairs, [&](size_t thread)
+    {
+        int item = 0;
+        for(size_t count = 0; count != perThread; count++)
+        {
+            if(thread < pairs)
+                while(!push((int)count))
+                    std::this_thread::yield();
+            else
+                while(!pop(item))
+                    std::this_thread::yield();
+        }
+    });
+}
+
+// The baseline for the queues: LinkedList behind one mutex.
+struct LockedList
+{
+    std::mutex mutex;
+    aisdi::LinkedList<int> list;
+
+    bool append(int item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.append(item);
+        return true;
+    }
+
+    bool popFirst(int& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(list.isEmpty())
+            return false;
+        item = list.popFirst();
+        return true;
+    }
+};
 
+void perfomSpscTest(size_t amount)
+{
+    LockedList list;
+    auto list_time = transferOnThreads(1, amount, [&](int item)
+    {
+        return list.append(item);
+    }, [&](int& item)
+    {
+        return list.popFirst(item);
+    });
+
+    aisdi::SpscRing<int> ring(1024);
+    auto ring_time = transferOnThreads(1, amount, [&](int item)
+    {
+        return ring.tryPush(item);
+    }, [&](int& item)
+    {
+        return ring.tryPop(item);
+    });
+
+    const size_t batchSize = 64;
+    auto batch_time = runOnThreads(2, [&](size_t thread)
+    {
+        int batch[batchSize];
+        size_t done = 0;
+        while(done != amount)
+        {
+            const size_t wanted = amount - done < batchSize ? amount - done : batchSize;
+            size_t moved;
+            if(thread == 0)
+            {
+                for(size_t i = 0; i != wanted; i++)
+                    batch[i] = (int)(done + i);
+                moved = ring.tryPushN(batch, wanted);
+            }
+            else
+                moved = ring.tryPopN(batch, wanted);
+            done += moved;
+            if(moved == 0)
+                std::this_thread::yield();
+        }
+    });
+
+    // latency: one item bounces between the threads through two rings
+    const size_t roundTrips = amount < 10000 ? amount : 10000;
+    aisdi::SpscRing<int> back(1024);
+    auto pingpong_time = runOnThreads(2, [&](size_t thread)
+    {
+        aisdi::SpscRing<int>& in = thread == 0 ? back : ring;
+        aisdi::SpscRing<int>& out = thread == 0 ? ring : back;
+        int item = 0;
+        for(size_t trip = 0; trip != roundTrips; trip++)
+        {
+            if(thread == 0)
+                out.tryPush(item);
+            while(!in.tryPop(item))
+                std::this_thread::yield();
+            if(thread == 1)
+                out.tryPush(item);
+        }
+    });
+
+    std::cout<<"Handing "<<amount<<" elements to another thread took [us]"<<std::endl<<
+             list_time<<" in mutex and list"<<std::endl<<
+             ring_time<<" in spsc ring"<<std::endl<<
+             batch_time<<" in spsc ring, batches of "<<batchSize<<std::endl<<
+             "Round trip latency [ns]: "<<pingpong_time * 1000.0 / roundTrips<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomMpmcTest(size_t amount)
+{
+    std::cout<<"Passing "<<amount<<" elements through a queue, throughput [Mitems/s]"<<std::endl;
+    for(size_t pairs = 2; pairs <= 16; pairs *= 2)
+    {
+        LockedList list;
+        auto list_time = transferOnThreads(pairs, amount, [&](int item)
+        {
+            return list.append(item);
+        }, [&](int& item)
+        {
+            return list.popFirst(item);
+        });
+
+        aisdi::MpmcQueue<int> queue(1024);
+        auto queue_time = transferOnThreads(pairs, amount, [&](int item)
+        {
+            return queue.tryPush(item);
+        }, [&](int& item)
+        {
+            return queue.tryPop(item);
+        });
+
+        const double total = (double)(amount / pairs * pairs);
+        std::cout<<pairs<<" producers and "<<pairs<<" consumers: "<<
+                 total / (list_time + 1)<<" with mutex and list, "<<
+                 total / (queue_time + 1)<<" with mpmc queue"<<std::endl;
+    }
+    std::cout<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomLinkedQueueTest(size_t amount)
+{
+    std::cout<<"Passing "<<amount<<" elements through an unbounded queue, throughput [Mitems/s]"<<std::endl;
+    for(size_t pairs = 1; pairs <= 8; pairs *= 2)
+    {
+        LockedList list;
+        auto list_time = transferOnThreads(pairs, amount, [&](int item)
+        {
+            return list.append(item);
+        }, [&](int& item)
+        {
+            return list.popFirst(item);
+        });
+
+        aisdi::ConcurrentLinkedQueue<int> queue;
+        auto queue_time = transferOnThreads(pairs, amount, [&](int item)
+        {
+            queue.append(item);
+            return true;
+        }, [&](int& item)
+        {
+            return queue.popFirst(item);
+        });
+
+        const double total = (double)(amount / pairs * pairs);
+        std::cout<<pairs<<" producers and "<<pairs<<" consumers: "<<
+                 total / (list_time + 1)<<" with mutex and list, "<<
+                 total / (queue_time + 1)<<" with concurrent linked queue"<<std::endl;
+    }
+    std::cout<<std::endl<<std::endl<<std::endl;
+}
+
+// The baseline for the ordered set: sorted LinkedList behind one mutex.
+struct LockedSortedList
+{
+    std::mutex mutex;
+    aisdi::LinkedList<int> list;
+
+    aisdi::LinkedList<int>::const_iterator lowerBound(int item) const
+    {
+        auto position = list.cbegin();
+        while(position != list.cend() and *position < item)
+            position++;
+        return position;
+    }
+
+    bool contains(int item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto position = lowerBound(item);
+        return position != list.cend() and *position == item;
+    }
+
+    bool insert(int item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto position = lowerBound(item);
+        if(position != list.cend() and *position == item)
+            return false;
+        list.insert(position, item);
+        return true;
+    }
+
+    bool erase(int item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto position = lowerBound(item);
+        if(position == list.cend() or *position != item)
+            return false;
+        list.erase(position);
+        return true;
+    }
+};
+
+// Runs operations spread over threads on set, reading readPercent of the time
+// and otherwise inserting or erasing with equal odds, over keys [0, keys).
+template <typename Set>
+long long runSetMix(Set& set, size_t threads, size_t operations, unsigned readPercent, int keys)
+{
+    return runOnThreads(threads, [&](size_t thread)
+    {
+        unsigned state = 2463534242u + (unsigned)thread;
+        for(size_t count = 0; count != operations / threads; count++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            const int key = (int)((state >> 8) % keys);
+            const unsigned dice = state % 100;
+            if(dice < readPercent)
+                set.contains(key);
+            else if((dice - readPercent) % 2 == 0)
+                set.insert(key);
+            else
+                set.erase(key);
+        }
+    });
+}
+
+void perfomOrderedListTest(size_t amount)
+{
+    // a lock-holding scan of the whole list per operation - keep it bounded
+    const size_t operations = amount < 100000 ? amount : 100000;
+    const int keys = 512;
+    const unsigned readPercents[] = { 90, 50, 10 };
+    const char* mixNames[] = { "read-heavy", "balanced", "write-heavy" };
+    auto counts = threadCounts();
+    std::cout<<operations<<" operations on "<<keys<<" keys, throughput [Mops/s]"<<std::endl;
+    for(size_t mix = 0; mix != 3; mix++)
+    {
+        for(auto threads = counts.cbegin(); threads != counts.cend(); threads++)
+        {
+            LockedSortedList locked;
+            aisdi::ConcurrentOrderedList<int> concurrent;
+            for(int key = 0; key < keys; key += 2)
+            {
+                locked.insert(key);
+                concurrent.insert(key);
+            }
+            auto locked_time = runSetMix(locked, *threads, operations, readPercents[mix], keys);
+            auto concurrent_time = runSetMix(concurrent, *threads, operations, readPercents[mix], keys);
+
+            const double total = (double)(operations / *threads * *threads);
+            std::cout<<mixNames[mix]<<", "<<*threads<<" threads: "<<
+                     total / (locked_time + 1)<<" with mutex and list, "<<
+                     total / (concurrent_time + 1)<<" with concurrent ordered list"<<std::endl;
+        }
+    }
+    std::cout<<std::endl<<std::endl<<std::endl;
+}
+
+// The baseline for RcuVector: Vector behind a reader-writer lock.
+struct RwLockedVector
+{
+    pthread_rwlock_t lock;
+    aisdi::Vector<int> items;
+
+    explicit RwLockedVector(const aisdi::Vector<int>& initial)
+        : items(initial)
+    {
+        pthread_rwlock_init(&lock, nullptr);
+    }
+
+    ~RwLockedVector()
+    {
+        pthread_rwlock_destroy(&lock);
+    }
+};
+
+// Runs readers threads doing lookups lookup(thread, count) each while one more
+// thread calls update() every millisecond until they finish. Returns the
+// slowest reader's time in microseconds; updates gets the number of updates.
+template <typename Lookup, typename Update>
+long long readWhileWriting(size_t readers, size_t lookups, Lookup lookup, Update update,
+                           size_t& updates)
+{
+    using namespace std::chrono;
+    std::atomic<size_t> running(readers);
+    std::atomic<long long> slowest(0);
+    std::atomic<long long> sum(0);
+    updates = 0;
+    runOnThreads(readers + 1, [&](size_t thread)
+    {
+        if(thread == readers)
+        {
+            while(running.load() != 0)
+            {
+                update();
+                updates++;
+                std::this_thread::sleep_for(milliseconds(1));
+            }
+            return;
+        }
+        long long local = 0;
+        high_resolution_clock::time_point t1 = high_resolution_clock::now();
+        for(size_t count = 0; count != lookups; count++)
+            local += lookup(thread, count);
+        high_resolution_clock::time_point t2 = high_resolution_clock::now();
+        const long long time = duration_cast<microseconds>( t2 - t1 ).count();
+        long long previous = slowest.load();
+        while(previous < time and !slowest.compare_exchange_weak(previous, time))
+        {}
+        sum += local;
+        running--;
+    });
+    return slowest.load();
+}
+
+void perfomRcuTest(size_t amount)
+{
+    const size_t lookups = 1000000;
+    aisdi::Vector<int> table;
+    table.reserve(amount);
+    for(size_t i = 0; i != amount; i++)
+        table.append((int)i);
+    auto counts = threadCounts();
+    std::cout<<"Random lookups in a table of "<<amount<<
+             " elements while it is updated, reader throughput [Mlookups/s]"<<std::endl;
+    for(auto readers = counts.cbegin(); readers != counts.cend(); readers++)
+    {
+        RwLockedVector locked(table);
+        size_t locked_updates;
+        auto locked_time = readWhileWriting(*readers, lookups, [&](size_t thread, size_t count)
+        {
+            pthread_rwlock_rdlock(&locked.lock);
+            const int value = locked.items.data()[(count * 7919 + thread) % amount];
+            pthread_rwlock_unlock(&locked.lock);
+            return value;
+        }, [&]()
+        {
+            pthread_rwlock_wrlock(&locked.lock);
+            locked.items.data()[0]++;
+            pthread_rwlock_unlock(&locked.lock);
+        }, locked_updates);
+
+        aisdi::RcuVector<int> rcu(table);
+        size_t rcu_updates;
+        auto rcu_time = readWhileWriting(*readers, lookups, [&](size_t thread, size_t count)
+        {
+            aisdi::RcuVector<int>::Snapshot snapshot(rcu);
+            return snapshot->data()[(count * 7919 + thread) % amount];
+        }, [&]()
+        {
+            rcu.update([](aisdi::Vector<int>& items) { items.data()[0]++; });
+        }, rcu_updates);
+
+        const double total = (double)lookups * *readers;
+        std::cout<<*readers<<" readers: "<<
+                 total / (locked_time + 1)<<" with rwlock and vector ("<<locked_updates<<" updates), "<<
+                 total / (rcu_time + 1)<<" with rcu vector ("<<rcu_updates<<" updates)"<<std::endl;
+    }
+    std::cout<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomBitVectorTest(size_t amount)
+{
+    using namespace std::chrono;
+    const size_t repeats = 100000000 / amount;
+    aisdi::Vector<bool> flags, mask;
+    aisdi::BitVector bitFlags, bitMask;
+    for(size_t count = 0; count != amount; count++)
+    {
+        const bool flag = (count * 7919) % 3 != 0;
+        const bool selected = (count * 104729) % 5 < 2;
+        flags.append(flag);
+        mask.append(selected);
+        bitFlags.append(flag);
+        bitMask.append(selected);
+    }
+
+    //and + count, as a filter pipeline step
+    size_t vector_count = 0;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        aisdi::Vector<bool> result = flags;
+        auto m = mask.cbegin();
+        for(auto i = result.begin(); i != result.end(); i++, m++)
+            *i = *i and *m;
+        for(auto i = result.cbegin(); i != result.cend(); i++)
+            vector_count += *i;
+    }
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    size_t bit_count = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t repeat = 0; repeat != repeats; repeat++)
+    {
+        aisdi::BitVector result = bitFlags;
+        result &= bitMask;
+        bit_count += result.count();
+    }
+    t2 = high_resolution_clock::now();
+
+    auto bit_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    const double total = (double)amount * repeats;
+    std::cout<<"Masking and counting "<<amount<<" flags "<<repeats<<" times, throughput [Mflags/s]"<<std::endl<<
+             total / (vector_time + 1)<<" in vector<bool>, "<<flags.getCapacity() * sizeof(bool)<<" B (count "<<vector_count<<")"<<std::endl<<
+             total / (bit_time + 1)<<" in bit vector, "<<bitFlags.getBytes()<<" B (count "<<bit_count<<")"<<std::endl;
+
+    //visiting the set bits
+    size_t vector_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t count = 0; count != amount; count++)
+        if(mask.data()[count])
+            vector_sum += count;
+    t2 = high_resolution_clock::now();
+
+    vector_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    size_t bit_sum = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t index = bitMask.findFirstSet(); index != amount; index = bitMask.findNextSet(index))
+        bit_sum += index;
+    t2 = high_resolution_clock::now();
+
+    bit_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Visiting set flags took [us] (sum "<<vector_sum<<"/"<<bit_sum<<")"<<std::endl<<
+             vector_time<<" in vector<bool>"<<std::endl<<
+             bit_time<<" in bit vector"<<std::endl<<std::endl<<std::endl<<std::endl;
+}
+
+void perfomCapacityHintTest(size_t amount)
+{
+    using namespace std::chrono;
+    using CountedVector = aisdi::Vector<int, aisdi::CountingContainerStats>;
+    using CountedHintedVector = aisdi::HintedVector<int, aisdi::CountingContainerStats>;
+    const size_t rounds = 10;
+    // one site per size, as distinct call sites would have
+    aisdi::CapacityHintSite& site =
+        aisdi::CapacityHints::instance().site("perfomCapacityHintTest/" + std::to_string(amount));
+    const size_t startingHint = site.getHint();
+
+    //filling a fresh vector per round
+    size_t plain_reallocations = 0;
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    for(size_t round = 0; round != rounds; round++)
+    {
+        CountedVector vector;
+        for(size_t count = 0; count != amount; count++)
+            vector.append((int)count);
+        plain_reallocations += vector.stats().reallocations;
+    }
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+    auto plain_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    size_t hinted_reallocations = 0;
+    t1 = high_resolution_clock::now();
+    for(size_t round = 0; round != rounds; round++)
+    {
+        CountedHintedVector vector(site);
+        for(size_t count = 0; count != amount; count++)
+            vector.append((int)count);
+        hinted_reallocations += vector.stats().reallocations;
+    }
+    t2 = high_resolution_clock::now();
+
+    auto hinted_time = duration_cast<microseconds>( t2 - t1 ).count();
+
+    std::cout<<"Filling "<<rounds<<" vectors of "<<amount<<" elements took [us]"<<std::endl<<
+             plain_time<<" without hints, "<<plain_reallocations<<" reallocations"<<std::endl<<
+             hinted_time<<" with hints (starting at "<<startingHint<<"), "<<hinted_reallocations<<" reallocations"<<std::endl<<std::endl<<std::endl<<std::endl;
 }
 
 } // namespace
 
+// With -DAISDI_CONTAINER_STATS=ON: what the containers of the run did.
+void dumpContainerStats()
+{
+#ifdef AISDI_CONTAINER_STATS
+    std::cerr<<"Container statistics:"<<std::endl;
+    aisdi::ContainerStatsRegistry::instance().dump(std::cerr);
+#endif
+}
+
 int main(int argc, char** argv)
 {
-    /*const std::size_t repeatCount = argc > 1 ? std::atoll(argv[1]) : 10000;
-    for (std::size_t i = 0; i < repeatCount; ++i)
-        perfomTest();
-    return 0;*/
-    for(size_t amount=1000; amount<=1000000 ; amount*=10)
-        perfomTest(amount);
+    if(argc < 2)
+    {
+        std::cerr<<"usage: "<<argv[0]<<" persistent|soa|compressed|mapped|removeif|flatmap|concurrent|"
+                   "spsc|mpmc|linkedqueue|orderedlist|rcu|bitvector|hints [hint file]"<<std::endl<<
+                   "Vector and LinkedList operations are benchmarked by aisdiBenchmarks"<<std::endl;
+        return 2;
+    }
+    const std::string mode = argv[1];
+    if(mode == "flatmap")
+    {
+        for(size_t amount=1000; amount<=10000000 ; amount*=10)
+            perfomFlatMapTest(amount);
+        dumpContainerStats();
+        return 0;
+    }
+    // hints learned by earlier runs; pass a file name to keep them
+    const std::string hintsPath = mode == "hints" and argc > 2 ? argv[2] : "";
+    if(!hintsPath.empty() and std::ifstream(hintsPath.c_str()))
+        aisdi::CapacityHints::instance().load(hintsPath);
+    // a failing test unwinds to here, so whatever it holds is cleaned up
+    try
+    {
+        for(size_t amount=1000; amount<=1000000 ; amount*=10)
+        {
+            if(mode == "persistent")
+                perfomPersistentTest(amount);
+            else if(mode == "soa")
+                perfomSoATest(amount);
+            else if(mode == "compressed")
+                perfomCompressedTest(amount);
+            else if(mode == "mapped")
+                perfomMappedTest(amount);
+            else if(mode == "removeif")
+                perfomRemoveIfTest(amount);
+            else if(mode == "concurrent")
+                perfomConcurrentAppendTest(amount);
+            else if(mode == "spsc")
+                perfomSpscTest(amount);
+            else if(mode == "mpmc")
+                perfomMpmcTest(amount);
+            else if(mode == "linkedqueue")
+                perfomLinkedQueueTest(amount);
+            else if(mode == "orderedlist")
+                perfomOrderedListTest(amount);
+            else if(mode == "rcu")
+                perfomRcuTest(amount);
+            else if(mode == "bitvector")
+                perfomBitVectorTest(amount);
+            else if(mode == "hints")
+                perfomCapacityHintTest(amount);
+            else
+            {
+                std::cerr<<"Unknown mode "<<mode<<std::endl;
+                return 2;
+            }
+        }
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr<<error.what()<<std::endl;
+        return 1;
+    }
+    if(!hintsPath.empty())
+        aisdi::CapacityHints::instance().save(hintsPath);
+    dumpContainerStats();
     return 0;
 }
@@ -0,0 +1,116 @@
+#include <AllocationCounter.h>
+#include <Benchmark.h>
+#include <LinearBenchmarks.h>
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+// Runs one registered linear benchmark with allocation counting.
+aisdi::bench::Result runCounted(const std::string& operation, std::size_t size)
+{
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerLinearBenchmarks<aisdi::Vector<int>>(registry, "Vector", "int");
+  aisdi::bench::registerLinearBenchmarks<aisdi::LinkedList<int>>(registry, "LinkedList", "int");
+  aisdi::bench::Options options;
+  options.repetitions = 2;
+  options.minSampleMicroseconds = 0;
+  options.allocations = true;
+  options.filters = { operation };
+  options.sizes = { size };
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+  BOOST_REQUIRE_EQUAL(results.getSize(), 1);
+  return *results.begin();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(AllocationCounterTests)
+
+BOOST_AUTO_TEST_CASE(GivenLinkedHooks_WhenCountingAllocations_ThenNewAndDeleteAreCounted)
+{
+  BOOST_REQUIRE(aisdi::bench::allocationHooksInstalled());
+  aisdi::bench::AllocationCounter counter;
+
+  std::unique_ptr<int> first(new int(1));
+  std::unique_ptr<int[]> second(new int[100]);
+  first.reset();
+
+  const aisdi::bench::AllocationCounts& counts = counter.stop();
+  BOOST_CHECK_EQUAL(counts.allocations, 2);
+  BOOST_CHECK_EQUAL(counts.frees, 1);
+  BOOST_CHECK_EQUAL(counts.bytes, sizeof(int) + 100 * sizeof(int));
+  BOOST_CHECK(counts.peakLiveBytes >= (long long)(sizeof(int) + 100 * sizeof(int)));
+  BOOST_CHECK(counts.liveBytes >= (long long)(100 * sizeof(int)));
+}
+
+BOOST_AUTO_TEST_CASE(GivenStoppedCounter_WhenAllocating_ThenNothingMoreIsCounted)
+{
+  aisdi::bench::AllocationCounter counter;
+  counter.stop();
+
+  std::unique_ptr<int> item(new int(1));
+
+  BOOST_CHECK_EQUAL(counter.stop().allocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedListAppend_WhenCountingAllocations_ThenThereIsOneNodePerElement)
+{
+  const aisdi::bench::Result result = runCounted("append/LinkedList/int/*", 1000);
+
+  BOOST_REQUIRE(result.allocationsCounted);
+  BOOST_CHECK_EQUAL(result.allocationsPerOperation, 1.0);
+  BOOST_CHECK_EQUAL(result.freesPerOperation, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorAppend_WhenCountingAllocations_ThenGrowthIsAmortized)
+{
+  const aisdi::bench::Result result = runCounted("append/Vector/int/*", 1024);
+
+  // doubling from 2 to 1024 elements
+  BOOST_CHECK_EQUAL(result.allocationsPerOperation, 9.0 / 1024);
+  BOOST_CHECK_EQUAL(result.freesPerOperation, 9.0 / 1024);
+  BOOST_CHECK(result.bytesPerOperation < 2 * 2 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedListPop_WhenCountingAllocations_ThenEveryPopFreesOneNode)
+{
+  const aisdi::bench::Result result = runCounted("pop/LinkedList/int/*", 1000);
+
+  BOOST_CHECK_EQUAL(result.allocationsPerOperation, 0.0);
+  BOOST_CHECK_EQUAL(result.freesPerOperation, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenReadingAndShrinkingVector_WhenCountingAllocations_ThenNothingIsAllocated)
+{
+  const char* operations[] = { "iterate/Vector/int/*", "pop/Vector/int/*", "erase-range/Vector/int/*" };
+  for(const char* operation : operations)
+  {
+    const aisdi::bench::Result result = runCounted(operation, 1000);
+    BOOST_CHECK_EQUAL(result.allocationsPerOperation, 0.0);
+    BOOST_CHECK_EQUAL(result.freesPerOperation, 0.0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoAllocationsOption_WhenRunning_ThenAllocationsAreNotCounted)
+{
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerLinearBenchmarks<aisdi::LinkedList<int>>(registry, "LinkedList", "int");
+  aisdi::bench::Options options;
+  options.repetitions = 1;
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::bench::Result result = aisdi::bench::runCase(*registry.getCases().begin(), 10, options);
+
+  BOOST_CHECK(!result.allocationsCounted);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
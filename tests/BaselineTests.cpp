@@ -0,0 +1,144 @@
+#include <Baseline.h>
+#include <Benchmark.h>
+#include <Vector.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include "TemporaryFile.h"
+
+namespace
+{
+
+struct BaselineFile : TemporaryFile
+{
+  BaselineFile()
+    : TemporaryFile("aisdi_benchmark_baseline_test.txt")
+  {}
+};
+
+aisdi::bench::Result resultWith(const aisdi::Vector<double>& samples)
+{
+  aisdi::bench::Result result;
+  result.operation = "append";
+  result.container = "Vector";
+  result.element = "int";
+  result.size = 1000;
+  result.batch = 1;
+  result.samples = samples;
+  result.nanosecondsPerOperation = aisdi::bench::summarize(samples);
+  return result;
+}
+
+const aisdi::Vector<double> usual = { 10.0, 10.2, 9.9, 10.1, 10.0, 10.3, 9.8, 10.1, 10.0, 10.2 };
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(BaselineTests, BaselineFile)
+
+BOOST_AUTO_TEST_CASE(GivenCandidateAboveEveryBaselineSample_WhenTesting_ThenSlowdownIsSignificant)
+{
+  const aisdi::Vector<double> baseline = { 1, 2, 3, 4, 5 };
+  const aisdi::Vector<double> candidate = { 6, 7, 8, 9, 10 };
+
+  // exact test gives 1/252; the normal approximation about 0.006
+  BOOST_CHECK(aisdi::bench::mannWhitneyGreaterPValue(baseline, candidate) < 0.01);
+  BOOST_CHECK(aisdi::bench::mannWhitneyGreaterPValue(candidate, baseline) > 0.99);
+}
+
+BOOST_AUTO_TEST_CASE(GivenInterleavedSamples_WhenTesting_ThenNothingIsSignificant)
+{
+  const aisdi::Vector<double> baseline = { 1, 3, 5, 7, 9 };
+  const aisdi::Vector<double> candidate = { 2, 4, 6, 8, 10 };
+
+  const double p = aisdi::bench::mannWhitneyGreaterPValue(baseline, candidate);
+  BOOST_CHECK(p > 0.2);
+  BOOST_CHECK(p < 0.8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllSamplesTied_WhenTesting_ThenPValueIsOne)
+{
+  const aisdi::Vector<double> same = { 4, 4, 4 };
+
+  BOOST_CHECK_EQUAL(aisdi::bench::mannWhitneyGreaterPValue(same, same), 1.0);
+  BOOST_CHECK_EQUAL(aisdi::bench::mannWhitneyGreaterPValue(same, aisdi::Vector<double>()), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedBaseline_WhenLoading_ThenEverySampleIsBack)
+{
+  const aisdi::Vector<aisdi::bench::Result> results = { resultWith({ 1.5, 2.25, 1e-3 }) };
+  aisdi::bench::saveBaseline(path, results);
+
+  const aisdi::bench::Baseline baseline = aisdi::bench::loadBaseline(path);
+
+  BOOST_REQUIRE_EQUAL(baseline.size(), 1);
+  const aisdi::Vector<double>& samples = baseline.at("append/Vector/int/1000");
+  BOOST_REQUIRE_EQUAL(samples.getSize(), 3);
+  BOOST_CHECK_EQUAL(*(samples.begin() + 1), 2.25);
+  BOOST_CHECK_EQUAL(*(samples.begin() + 2), 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOtherFile_WhenLoadingBaseline_ThenExceptionIsThrown)
+{
+  std::ofstream(path.c_str())<<"append/Vector/int/1000 1 2 3\n";
+
+  BOOST_CHECK_THROW(aisdi::bench::loadBaseline(path), std::runtime_error);
+  BOOST_CHECK_THROW(aisdi::bench::loadBaseline(path + ".missing"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenClearSlowdown_WhenComparing_ThenItIsARegression)
+{
+  aisdi::bench::Baseline baseline;
+  baseline["append/Vector/int/1000"] = usual;
+  aisdi::Vector<double> slower;
+  for(double sample : usual)
+    slower.append(sample * 1.3);
+
+  const aisdi::Vector<aisdi::bench::Comparison> comparisons =
+    aisdi::bench::compareWithBaseline(baseline, { resultWith(slower) }, 0.01, 0.05);
+
+  BOOST_REQUIRE_EQUAL(comparisons.getSize(), 1);
+  BOOST_CHECK((*comparisons.begin()).regression);
+  BOOST_CHECK_CLOSE((*comparisons.begin()).change, 0.3, 1e-6);
+  BOOST_CHECK(aisdi::bench::hasRegression(comparisons));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSignificantButSmallSlowdown_WhenComparing_ThenThresholdLetsItPass)
+{
+  aisdi::bench::Baseline baseline;
+  baseline["append/Vector/int/1000"] = usual;
+  aisdi::Vector<double> slightlySlower;
+  for(double sample : usual)
+    slightlySlower.append(sample + 0.5);
+
+  const aisdi::Vector<aisdi::bench::Comparison> comparisons =
+    aisdi::bench::compareWithBaseline(baseline, { resultWith(slightlySlower) }, 0.01, 0.10);
+
+  BOOST_REQUIRE_EQUAL(comparisons.getSize(), 1);
+  BOOST_CHECK((*comparisons.begin()).slowerPValue < 0.01);
+  BOOST_CHECK(!aisdi::bench::hasRegression(comparisons));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSpeedupOrUnknownBenchmark_WhenComparing_ThenThereIsNoRegression)
+{
+  aisdi::bench::Baseline baseline;
+  baseline["append/Vector/int/1000"] = usual;
+  aisdi::Vector<double> faster;
+  for(double sample : usual)
+    faster.append(sample / 2);
+  aisdi::bench::Result unknown = resultWith(usual);
+  unknown.container = "LinkedList";
+
+  const aisdi::Vector<aisdi::bench::Comparison> comparisons =
+    aisdi::bench::compareWithBaseline(baseline, { resultWith(faster), unknown }, 0.01, 0.05);
+
+  BOOST_REQUIRE_EQUAL(comparisons.getSize(), 1);
+  BOOST_CHECK((*comparisons.begin()).improvement);
+  BOOST_CHECK(!aisdi::bench::hasRegression(comparisons));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+#include <Benchmark.h>
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+aisdi::bench::Options parse(const char* argument)
+{
+  const char* argv[] = { "aisdiBenchmarks", argument };
+  return aisdi::bench::parseOptions(2, argv);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(BenchmarkTests)
+
+BOOST_AUTO_TEST_CASE(GivenSamples_WhenSummarizing_ThenMedianMinAndStddevAreComputed)
+{
+  const aisdi::bench::Summary summary = aisdi::bench::summarize({ 4.0, 1.0, 3.0, 2.0 });
+
+  BOOST_CHECK_EQUAL(summary.samples, 4);
+  BOOST_CHECK_CLOSE(summary.median, 2.5, 1e-9);
+  BOOST_CHECK_CLOSE(summary.min, 1.0, 1e-9);
+  BOOST_CHECK_CLOSE(summary.mean, 2.5, 1e-9);
+  BOOST_CHECK_CLOSE(summary.stddev, 1.2909944487, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSingleSample_WhenSummarizing_ThenStddevIsZero)
+{
+  const aisdi::bench::Summary summary = aisdi::bench::summarize({ 7.0 });
+
+  BOOST_CHECK_EQUAL(summary.median, 7.0);
+  BOOST_CHECK_EQUAL(summary.stddev, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPatternWithWildcards_WhenMatching_ThenStarMatchesAnyText)
+{
+  BOOST_CHECK(aisdi::bench::matchesPattern("append/*/int/*", "append/Vector/int/1000"));
+  BOOST_CHECK(aisdi::bench::matchesPattern("*", ""));
+  BOOST_CHECK(!aisdi::bench::matchesPattern("append/*/int/*", "append/Vector/string/1000"));
+  BOOST_CHECK(!aisdi::bench::matchesPattern("pop", "pop/Vector/int/1000"));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCommandLine_WhenParsing_ThenOptionsAreSet)
+{
+  const char* argv[] = { "aisdiBenchmarks", "--filter=pop/*", "--sizes=10,20", "--repetitions=3",
+                         "--format=csv" };
+  const aisdi::bench::Options options = aisdi::bench::parseOptions(5, argv);
+
+  BOOST_CHECK_EQUAL(options.filters.getSize(), 1);
+  BOOST_CHECK_EQUAL(options.sizes.getSize(), 2);
+  BOOST_CHECK_EQUAL(*(options.sizes.begin() + 1), 20);
+  BOOST_CHECK_EQUAL(options.repetitions, 3);
+  BOOST_CHECK_EQUAL(options.format, "csv");
+  BOOST_CHECK(aisdi::bench::isSelected(options, "pop/Vector/int/10"));
+  BOOST_CHECK(!aisdi::bench::isSelected(options, "append/Vector/int/10"));
+}
+
+BOOST_AUTO_TEST_CASE(GivenBadCommandLine_WhenParsing_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(parse("--sizes=10,x"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("--sizes=0"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("--sizes=10,0"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("--format=xml"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse("--unknown"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenArgumentsOfAnyProgram_WhenSplittingAndReadingLists_ThenSharedRulesApply)
+{
+  const aisdi::bench::CommandLineOption option("--threads=1,2,4=x");
+  const aisdi::bench::CommandLineOption flag("--no-pin");
+  const aisdi::Vector<aisdi::bench::size_type> counts = aisdi::bench::detail::parseCountList("--threads", "1,2,4");
+  const aisdi::Vector<std::string> filters = { "own/*", "shared/*" };
+
+  BOOST_CHECK_EQUAL(option.name, "--threads");
+  BOOST_CHECK_EQUAL(option.value, "1,2,4=x");
+  BOOST_CHECK_EQUAL(flag.name, "--no-pin");
+  BOOST_CHECK(flag.value.empty());
+  BOOST_CHECK_EQUAL(counts.getSize(), 3);
+  BOOST_CHECK_EQUAL(*(counts.end() - 1), 4);
+  BOOST_CHECK_THROW(aisdi::bench::detail::parseCountList("--threads", ""), std::invalid_argument);
+  BOOST_CHECK(aisdi::bench::isSelected(filters, "shared/Vector/int/2"));
+  BOOST_CHECK(!aisdi::bench::isSelected(filters, "padded/Vector/int/2"));
+  BOOST_CHECK(aisdi::bench::isSelected(aisdi::Vector<std::string>(), "padded/Vector/int/2"));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCase_WhenRun_ThenEveryRepetitionIsOneSampleOfTimedOperations)
+{
+  aisdi::bench::Registry registry;
+  std::size_t calls = 0;
+  registry.add("count", "none", "int", [&](aisdi::bench::Measurement& measurement, std::size_t size)
+  {
+    calls++;
+    measurement.time(size, [&]()
+    {
+      for(std::size_t i = 0; i != size; i++)
+        aisdi::bench::doNotOptimize(i);
+    });
+  });
+  aisdi::bench::Options options = parse("--repetitions=4");
+  options.sizes = { 8 };
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+
+  BOOST_REQUIRE_EQUAL(results.getSize(), 1);
+  const aisdi::bench::Result& result = *results.begin();
+  BOOST_CHECK_EQUAL(result.size, 8);
+  BOOST_CHECK_EQUAL(result.batch, 1);
+  BOOST_CHECK_EQUAL(result.nanosecondsPerOperation.samples, 4);
+  // one calibration run, then the samples
+  BOOST_CHECK_EQUAL(calls, 1 + 4);
+}
+
+BOOST_AUTO_TEST_CASE(GivenWarmup_WhenRun_ThenItsRunsFollowTheCalibrationRun)
+{
+  aisdi::bench::Registry registry;
+  std::size_t calls = 0;
+  registry.add("count", "none", "int", [&](aisdi::bench::Measurement& measurement, std::size_t size)
+  {
+    calls++;
+    measurement.time(size, [&]() {});
+  });
+  aisdi::bench::Options options = parse("--warmup=2");
+  options.sizes = { 8 };
+  options.repetitions = 3;
+  options.minSampleMicroseconds = 0;
+
+  aisdi::bench::runSelected(registry, options);
+
+  BOOST_CHECK_EQUAL(calls, 1 + 2 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenResults_WhenWritingCsv_ThenThereIsOneRowPerResultWithEmptyMissingCounters)
+{
+  aisdi::bench::Result result;
+  result.operation = "append";
+  result.container = "Vector";
+  result.element = "int";
+  result.size = 10;
+  result.batch = 2;
+  result.nanosecondsPerOperation = aisdi::bench::summarize({ 1.5 });
+  for(bool& counted : result.counted)
+    counted = false;
+  result.counted[aisdi::bench::instructionsCounter] = true;
+  result.countsPerOperation.values[aisdi::bench::instructionsCounter] = 4;
+  result.allocationsCounted = false;
+  const aisdi::Vector<aisdi::bench::Result> results = { result };
+
+  std::ostringstream out;
+  aisdi::bench::writeCsv(out, results);
+
+  BOOST_CHECK_EQUAL(out.str(), "operation,container,element,size,samples,batch,median_ns,min_ns,mean_ns,stddev_ns,"
+                               "cycles_per_op,instructions_per_op,l1d_misses_per_op,llc_misses_per_op,"
+                               "branch_misses_per_op,dtlb_misses_per_op,"
+                               "allocations_per_op,frees_per_op,bytes_per_op,peak_live_bytes,"
+                               "p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n"
+                               "append,Vector,int,10,1,2,1.5,1.5,1.5,0,,4,,,,,,,,,,,,,\n");
+}
+
+BOOST_AUTO_TEST_CASE(GivenPerfCounters_WhenMeasuring_ThenAvailableOnesCountAndMissingOnesAreExplained)
+{
+  aisdi::bench::PerfCounters counters;
+  aisdi::bench::Measurement measurement(&counters);
+
+  measurement.time(1000, [&]()
+  {
+    for(std::size_t i = 0; i != 1000; i++)
+      aisdi::bench::doNotOptimize(i);
+  });
+
+  if(counters.isAvailable(aisdi::bench::instructionsCounter))
+    BOOST_CHECK(measurement.getCounts().values[aisdi::bench::instructionsCounter] >= 1000);
+  else
+    BOOST_CHECK_EQUAL(measurement.getCounts().values[aisdi::bench::instructionsCounter], 0);
+  bool allAvailable = true;
+  for(std::size_t counter = 0; counter != aisdi::bench::counterCount; counter++)
+    allAvailable = allAvailable and counters.isAvailable(counter);
+  BOOST_CHECK_EQUAL(counters.getProblem().empty(), allAvailable);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoCounters_WhenRunningCase_ThenNothingIsCounted)
+{
+  aisdi::bench::Registry registry;
+  registry.add("noop", "none", "int", [](aisdi::bench::Measurement& measurement, std::size_t size)
+  {
+    measurement.time(size, []() {});
+  });
+  aisdi::bench::Options options = parse("--repetitions=2");
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::bench::Result result = aisdi::bench::runCase(*registry.getCases().begin(), 4, options);
+
+  for(bool counted : result.counted)
+    BOOST_CHECK(!counted);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
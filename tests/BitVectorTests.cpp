@@ -0,0 +1,209 @@
+#include <BitVector.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+// 0, 3, 6... set, over a size that doesn't end on a word boundary
+aisdi::BitVector everyThird(std::size_t size)
+{
+  aisdi::BitVector bits;
+  for(std::size_t i = 0; i != size; i++)
+    bits.append(i % 3 == 0);
+  return bits;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(BitVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::BitVector bits;
+
+  BOOST_CHECK(bits.isEmpty());
+  BOOST_CHECK(bits.begin() == bits.end());
+  BOOST_CHECK_EQUAL(bits.count(), 0);
+  BOOST_CHECK_EQUAL(bits.findFirstSet(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenCreatedWithInitializerList_ThenItContainsTheseBits)
+{
+  const aisdi::BitVector bits = { true, false, true };
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 3);
+  BOOST_CHECK(bits[0]);
+  BOOST_CHECK(!bits[1]);
+  BOOST_CHECK(bits.at(2));
+  BOOST_CHECK_THROW(bits.at(3), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSizeAndValue_WhenCreatingBitVector_ThenAllBitsHaveThatValue)
+{
+  const aisdi::BitVector bits(100, true);
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 100);
+  BOOST_CHECK_EQUAL(bits.count(), 100);
+  BOOST_CHECK_EQUAL(bits.getWordCount(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenAssigningThroughReference_ThenOnlyThatBitChanges)
+{
+  aisdi::BitVector bits(130);
+
+  bits[65] = true;
+  bits[129] = bits[65];
+  bits[0].flip();
+
+  BOOST_CHECK_EQUAL(bits.count(), 3);
+  BOOST_CHECK(bits[0]);
+  BOOST_CHECK(bits[65]);
+  BOOST_CHECK(bits[129]);
+  BOOST_CHECK(!bits[64]);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenSettingOutOfRange_ThenExceptionIsThrown)
+{
+  aisdi::BitVector bits(10);
+
+  BOOST_CHECK_THROW(bits.set(10, true), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenPoppingLast_ThenBitIsRemovedAndCleared)
+{
+  aisdi::BitVector bits = { false, true };
+
+  BOOST_CHECK(bits.popLast());
+  bits.append(false);
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 2);
+  BOOST_CHECK_EQUAL(bits.count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVectorEndingOnWordBoundary_WhenPoppingLast_ThenBitIsCleared)
+{
+  aisdi::BitVector bits(65, true);
+
+  bits.popLast();
+  bits.append(false);
+
+  BOOST_CHECK_EQUAL(bits.count(), 64);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyBitVector_WhenPoppingLast_ThenExceptionIsThrown)
+{
+  aisdi::BitVector bits;
+
+  BOOST_CHECK_THROW(bits.popLast(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoBitVectors_WhenCombiningWordWise_ThenResultMatchesPerBitLogic)
+{
+  const aisdi::BitVector threes = everyThird(200);
+  aisdi::BitVector evens;
+  for(std::size_t i = 0; i != 200; i++)
+    evens.append(i % 2 == 0);
+
+  aisdi::BitVector both = threes;
+  both &= evens;
+  aisdi::BitVector either = threes;
+  either |= evens;
+  aisdi::BitVector one = threes;
+  one ^= evens;
+
+  for(std::size_t i = 0; i != 200; i++)
+  {
+    BOOST_REQUIRE_EQUAL(both[i], i % 6 == 0);
+    BOOST_REQUIRE_EQUAL(either[i], i % 3 == 0 or i % 2 == 0);
+    BOOST_REQUIRE_EQUAL(one[i], (i % 3 == 0) != (i % 2 == 0));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVectorsOfDifferentSize_WhenCombining_ThenExceptionIsThrown)
+{
+  aisdi::BitVector bits(10);
+
+  BOOST_CHECK_THROW(bits &= aisdi::BitVector(11), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenNegated_ThenBitsPastTheEndStayClear)
+{
+  const aisdi::BitVector bits = everyThird(70);
+
+  const aisdi::BitVector inverted = ~bits;
+
+  BOOST_CHECK_EQUAL(inverted.count(), 70 - bits.count());
+  BOOST_CHECK_EQUAL(inverted.getWords()[1] >> 6, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenCounting_ThenSetBitsAreCounted)
+{
+  BOOST_CHECK_EQUAL(everyThird(1000).count(), 334);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSparseBitVector_WhenFindingSetBits_ThenTheyAreVisitedInOrder)
+{
+  aisdi::BitVector bits(1000);
+  bits.set(3, true);
+  bits.set(64, true);
+  bits.set(700, true);
+  bits.set(999, true);
+
+  BOOST_CHECK_EQUAL(bits.findFirstSet(), 3);
+  BOOST_CHECK_EQUAL(bits.findNextSet(3), 64);
+  BOOST_CHECK_EQUAL(bits.findNextSet(64), 700);
+  BOOST_CHECK_EQUAL(bits.findNextSet(700), 999);
+  BOOST_CHECK_EQUAL(bits.findNextSet(999), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenRankingAndSelecting_ThenResultsMatchWithAndWithoutIndex)
+{
+  aisdi::BitVector bits = everyThird(5000);
+  aisdi::BitVector indexed = bits;
+  indexed.buildRankIndex();
+
+  for(std::size_t i = 0; i <= 5000; i += 7)
+  {
+    BOOST_REQUIRE_EQUAL(bits.rank(i), (i + 2) / 3);
+    BOOST_REQUIRE_EQUAL(indexed.rank(i), (i + 2) / 3);
+  }
+  for(std::size_t k = 0; k != 1667; k++)
+  {
+    BOOST_REQUIRE_EQUAL(bits.select(k), 3 * k);
+    BOOST_REQUIRE_EQUAL(indexed.select(k), 3 * k);
+  }
+  BOOST_CHECK_EQUAL(bits.select(1667), 5000);
+  BOOST_CHECK_EQUAL(indexed.select(1667), 5000);
+  BOOST_CHECK_THROW(bits.rank(5001), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIndexedBitVector_WhenModified_ThenRankSeesTheChange)
+{
+  aisdi::BitVector bits(1000);
+  bits.buildRankIndex();
+
+  bits.set(10, true);
+
+  BOOST_CHECK_EQUAL(bits.rank(1000), 1);
+  BOOST_CHECK_EQUAL(bits.select(0), 10);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBitVector_WhenIterating_ThenBitsComeInOrder)
+{
+  const aisdi::BitVector bits = { true, false, false, true };
+  std::size_t index = 0;
+  const bool expected[] = { true, false, false, true };
+
+  for(auto i = bits.begin(); i != bits.end(); i++)
+    BOOST_REQUIRE_EQUAL(*i, expected[index++]);
+
+  BOOST_CHECK_EQUAL(index, 4);
+  BOOST_CHECK_THROW(*bits.end(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
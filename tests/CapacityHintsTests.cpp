@@ -0,0 +1,127 @@
+#include <CapacityHints.h>
+
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include "TemporaryFile.h"
+
+namespace
+{
+
+struct CapacityHintsFile : TemporaryFile
+{
+  CapacityHintsFile()
+    : TemporaryFile("aisdi_capacity_hints_test.txt")
+  {}
+};
+
+using CountedHintedVector = aisdi::HintedVector<int, aisdi::CountingContainerStats>;
+
+void fill(aisdi::Vector<int, aisdi::CountingContainerStats>& vector, int count)
+{
+  for(int i = 0; i != count; i++)
+    vector.append(i);
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CapacityHintsTests, CapacityHintsFile)
+
+BOOST_AUTO_TEST_CASE(GivenFreshSite_WhenCreatingHintedVector_ThenItStartsWithDefaultCapacity)
+{
+  aisdi::CapacityHintSite site;
+  const aisdi::HintedVector<int> vector(site);
+
+  BOOST_CHECK(vector.isEmpty());
+  BOOST_CHECK_EQUAL(vector.getCapacity(), aisdi::Vector<int>().getCapacity());
+}
+
+BOOST_AUTO_TEST_CASE(GivenHintedVector_WhenDestroyed_ThenNextOneAtTheSiteNeedsNoReallocation)
+{
+  aisdi::CapacityHintSite site;
+  {
+    CountedHintedVector first(site);
+    fill(first, 100);
+    BOOST_CHECK(first.stats().reallocations > 0);
+  }
+
+  CountedHintedVector second(site);
+  fill(second, 100);
+
+  BOOST_CHECK_EQUAL(site.getHint(), 100);
+  BOOST_CHECK_EQUAL(site.getSamples(), 1);
+  BOOST_CHECK_EQUAL(second.stats().reallocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSite_WhenSmallerSizesAreRecorded_ThenHintDecaysSlowly)
+{
+  aisdi::CapacityHintSite site;
+  site.record(800);
+  site.record(0);
+
+  BOOST_CHECK_EQUAL(site.getHint(), 700);
+
+  site.record(1000);
+
+  BOOST_CHECK_EQUAL(site.getHint(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMovedFromHintedVector_WhenDestroyed_ThenNothingIsRecorded)
+{
+  aisdi::CapacityHintSite site;
+  {
+    aisdi::HintedVector<int> vector(site);
+    vector.append(1);
+    aisdi::HintedVector<int> other(std::move(vector));
+  }
+
+  BOOST_CHECK_EQUAL(site.getSamples(), 1);
+  BOOST_CHECK_EQUAL(site.getHint(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllocationSiteMacro_WhenEvaluatedRepeatedly_ThenItNamesItsSourceLine)
+{
+  aisdi::CapacityHintSite* sites[2];
+  int line = 0;
+  for(int i = 0; i != 2; i++)
+  {
+    line = __LINE__; sites[i] = &AISDI_ALLOCATION_SITE;
+  }
+
+  BOOST_CHECK_EQUAL(sites[0], sites[1]);
+  BOOST_CHECK_EQUAL(sites[0], &aisdi::CapacityHints::instance().site(
+                                std::string(__FILE__) + ":" + std::to_string(line)));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedHints_WhenLoading_ThenSitesGetTheirHintsBack)
+{
+  aisdi::CapacityHints& hints = aisdi::CapacityHints::instance();
+  hints.site("CapacityHintsTests/saved site").restore(4096, 3);
+  hints.save(path);
+  hints.site("CapacityHintsTests/saved site").restore(0, 0);
+
+  hints.load(path);
+
+  BOOST_CHECK_EQUAL(hints.site("CapacityHintsTests/saved site").getHint(), 4096);
+  BOOST_CHECK_EQUAL(hints.site("CapacityHintsTests/saved site").getSamples(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMissingFile_WhenLoadingHints_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(aisdi::CapacityHints::instance().load(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMalformedFile_WhenLoadingHints_ThenExceptionIsThrown)
+{
+  std::ofstream(path.c_str())<<"twelve 1 site\n";
+
+  BOOST_CHECK_THROW(aisdi::CapacityHints::instance().load(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
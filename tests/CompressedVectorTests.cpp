@@ -0,0 +1,102 @@
+#include <CompressedVector.h>
+
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+// sorted ids with occasional small steps back, like our event ids
+std::uint64_t nearSortedId(std::size_t index)
+{
+  return 1000000000ull + index * 4 - (index % 7 == 0 ? 3 : 0);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompressedVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::CompressedVector collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(collection.getBlockCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNearSortedIds_WhenDecoding_ThenAllValuesAreReturned)
+{
+  aisdi::CompressedVector collection;
+  for(std::size_t i = 0; i != 1000; i++)
+    collection.append(nearSortedId(i));
+  std::uint64_t out[1000];
+
+  collection.decode(out);
+
+  for(std::size_t i = 0; i != 1000; i++)
+    BOOST_REQUIRE_EQUAL(out[i], nearSortedId(i));
+}
+
+BOOST_AUTO_TEST_CASE(GivenNearSortedIds_WhenMeasuringBytes_ThenTheyAreSmallerThanRawWords)
+{
+  aisdi::CompressedVector collection;
+  for(std::size_t i = 0; i != 64 * 1000; i++)
+    collection.append(nearSortedId(i));
+
+  BOOST_CHECK_LT(collection.getBytes(), 64 * 1000 * sizeof(std::uint64_t) / 4);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenDecodingFromMiddle_ThenSkipTableIsUsed)
+{
+  aisdi::CompressedVector collection;
+  for(std::size_t i = 0; i != 1000; i++)
+    collection.append(nearSortedId(i));
+  std::uint64_t out[100];
+
+  collection.decode(950, 50, out);
+
+  for(std::size_t i = 0; i != 50; i++)
+    BOOST_REQUIRE_EQUAL(out[i], nearSortedId(950 + i));
+  BOOST_CHECK_EQUAL(collection.at(500), nearSortedId(500));
+  BOOST_CHECK_EQUAL(collection.at(999), nearSortedId(999));
+}
+
+BOOST_AUTO_TEST_CASE(GivenExtremeValues_WhenDecoding_ThenFullWidthDeltasRoundTrip)
+{
+  aisdi::CompressedVector collection;
+  for(std::size_t i = 0; i != 130; i++)
+    collection.append(i % 2 == 0 ? 0 : ~std::uint64_t(0));
+
+  for(std::size_t i = 0; i != 130; i++)
+    BOOST_REQUIRE_EQUAL(collection.at(i), i % 2 == 0 ? 0 : ~std::uint64_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenReadingOutOfRange_ThenOperationThrows)
+{
+  aisdi::CompressedVector collection = { 1, 2, 3 };
+  std::uint64_t out[4];
+
+  BOOST_CHECK_THROW(collection.at(3), std::out_of_range);
+  BOOST_CHECK_THROW(collection.decode(1, 3, out), std::out_of_range);
+  BOOST_CHECK_THROW(collection.decodeBlock(1, out), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCopying_ThenCopyIsIndependent)
+{
+  aisdi::CompressedVector collection;
+  for(std::size_t i = 0; i != 100; i++)
+    collection.append(i);
+
+  aisdi::CompressedVector copy(collection);
+  copy.append(12345);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK_EQUAL(copy.getSize(), 101);
+  BOOST_CHECK_EQUAL(copy.at(70), 70);
+  BOOST_CHECK_EQUAL(copy.at(100), 12345);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+#include <ConcurrentAppendVector.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(ConcurrentAppendVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::ConcurrentAppendVector<int> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(collection.at(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenAppendingFromOneThread_ThenItemsKeepOrder)
+{
+  aisdi::ConcurrentAppendVector<int> collection;
+
+  for(int i = 0; i != 1000; i++)
+    BOOST_REQUIRE_EQUAL(collection.append(i), static_cast<std::size_t>(i));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+  int expected = 0;
+  for(auto i = collection.begin(); i != collection.end(); i++)
+    BOOST_REQUIRE_EQUAL(*i, expected++);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenAppending_ThenReferencesStayValid)
+{
+  aisdi::ConcurrentAppendVector<int> collection;
+  collection.append(7);
+  const int& first = collection[0];
+
+  for(int i = 0; i != 10000; i++)
+    collection.append(i);
+
+  BOOST_CHECK_EQUAL(first, 7);
+  BOOST_CHECK_EQUAL(&first, &collection[0]);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyProducers_WhenAppendingConcurrently_ThenEveryItemIsStoredOnce)
+{
+  const int threads = 8;
+  const int perThread = 20000;
+  aisdi::ConcurrentAppendVector<int> collection;
+
+  std::vector<std::thread> producers;
+  for(int t = 0; t != threads; t++)
+    producers.emplace_back([&collection, t, perThread]()
+    {
+      for(int i = 0; i != perThread; i++)
+        collection.append(t * perThread + i);
+    });
+  for(auto& producer : producers)
+    producer.join();
+
+  BOOST_REQUIRE_EQUAL(collection.getSize(), static_cast<std::size_t>(threads * perThread));
+  std::vector<int> seen(threads * perThread, 0);
+  for(auto i = collection.begin(); i != collection.end(); i++)
+    seen[*i]++;
+  for(int count : seen)
+    BOOST_REQUIRE_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenReader_WhenProducersAreAppending_ThenPublishedPrefixIsFullyWritten)
+{
+  const int threads = 4;
+  const int perThread = 20000;
+  aisdi::ConcurrentAppendVector<int> collection;
+  std::atomic<bool> done(false);
+  std::atomic<int> unwritten(0);
+
+  std::thread reader([&]()
+  {
+    while(!done.load())
+    {
+      std::size_t size = collection.getSize();
+      for(std::size_t i = 0; i != size; i++)
+        if(collection[i] == 0)
+          unwritten++;
+    }
+  });
+  std::vector<std::thread> producers;
+  for(int t = 0; t != threads; t++)
+    producers.emplace_back([&collection, perThread]()
+    {
+      for(int i = 0; i != perThread; i++)
+        collection.append(i + 1);
+    });
+  for(auto& producer : producers)
+    producer.join();
+  done.store(true);
+  reader.join();
+
+  BOOST_CHECK_EQUAL(unwritten.load(), 0);
+  BOOST_CHECK_EQUAL(collection.getSize(), static_cast<std::size_t>(threads * perThread));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
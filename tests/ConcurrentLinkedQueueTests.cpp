@@ -0,0 +1,123 @@
+#include <ConcurrentLinkedQueue.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(ConcurrentLinkedQueueTests)
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenCreated_ThenItIsEmpty)
+{
+  const aisdi::ConcurrentLinkedQueue<int> queue;
+
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyQueue_WhenPoppingFirst_ThenNothingIsReturned)
+{
+  aisdi::ConcurrentLinkedQueue<int> queue;
+  int item = 7;
+
+  BOOST_CHECK(!queue.popFirst(item));
+  BOOST_CHECK_EQUAL(item, 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenAppendingAndPopping_ThenItemsComeOutInOrder)
+{
+  aisdi::ConcurrentLinkedQueue<std::string> queue;
+
+  queue.append("a");
+  queue.append("b");
+  BOOST_CHECK(!queue.isEmpty());
+
+  std::string item;
+  BOOST_CHECK(queue.popFirst(item));
+  BOOST_CHECK_EQUAL(item, "a");
+  BOOST_CHECK(queue.popFirst(item));
+  BOOST_CHECK_EQUAL(item, "b");
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenNodesAreRecycledManyTimes_ThenOrderIsKept)
+{
+  aisdi::ConcurrentLinkedQueue<int> queue;
+  int expected = 0;
+  for(int i = 0; i != 100000; i++)
+  {
+    queue.append(i);
+    if(i % 3 != 0)
+    {
+      int item;
+      BOOST_REQUIRE(queue.popFirst(item));
+      BOOST_REQUIRE_EQUAL(item, expected++);
+    }
+  }
+  int item;
+  while(queue.popFirst(item))
+    BOOST_REQUIRE_EQUAL(item, expected++);
+  BOOST_CHECK_EQUAL(expected, 100000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyQueue_WhenDestroyed_ThenRemainingItemsAreReleased)
+{
+  aisdi::ConcurrentLinkedQueue<std::string> queue;
+  for(int i = 0; i != 100; i++)
+    queue.append(std::string(100, 'x'));
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyProducersAndConsumers_WhenTransferring_ThenQueueBehavesLikeFifo)
+{
+  const int producers = 4;
+  const int consumers = 4;
+  const int perProducer = 50000;
+  aisdi::ConcurrentLinkedQueue<int> queue;
+  std::vector<std::atomic<int>> seen(producers * perProducer);
+  for(auto& count : seen)
+    count.store(0);
+  std::atomic<int> remaining(producers * perProducer);
+  std::atomic<bool> ordered(true);
+
+  std::vector<std::thread> threads;
+  for(int p = 0; p != producers; p++)
+    threads.emplace_back([&queue, p, perProducer]()
+    {
+      for(int i = 0; i != perProducer; i++)
+        queue.append(p * perProducer + i);
+    });
+  for(int c = 0; c != consumers; c++)
+    threads.emplace_back([&]()
+    {
+      std::vector<int> last(producers, -1);
+      while(remaining.load() > 0)
+      {
+        int item;
+        if(!queue.popFirst(item))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        remaining--;
+        seen[item]++;
+        const int producer = item / perProducer;
+        if(item % perProducer <= last[producer])
+          ordered.store(false);
+        last[producer] = item % perProducer;
+      }
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  bool exactlyOnce = true;
+  for(auto& count : seen)
+    exactlyOnce = exactlyOnce and count.load() == 1;
+  BOOST_CHECK(exactlyOnce);
+  BOOST_CHECK(ordered.load());
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
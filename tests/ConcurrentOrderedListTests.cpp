@@ -0,0 +1,131 @@
+#include <ConcurrentOrderedList.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(ConcurrentOrderedListTests)
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenCreated_ThenItIsEmpty)
+{
+  const aisdi::ConcurrentOrderedList<int> list;
+
+  BOOST_CHECK(list.isEmpty());
+  BOOST_CHECK(!list.contains(0));
+}
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenInsertingItems_ThenTheyAreContained)
+{
+  aisdi::ConcurrentOrderedList<std::string> list;
+
+  BOOST_CHECK(list.insert("b"));
+  BOOST_CHECK(list.insert("a"));
+  BOOST_CHECK(list.insert("c"));
+
+  BOOST_CHECK_EQUAL(list.getSize(), 3);
+  BOOST_CHECK(list.contains("a"));
+  BOOST_CHECK(list.contains("b"));
+  BOOST_CHECK(list.contains("c"));
+  BOOST_CHECK(!list.contains("d"));
+}
+
+BOOST_AUTO_TEST_CASE(GivenListWithItem_WhenInsertingItAgain_ThenFalseIsReturned)
+{
+  aisdi::ConcurrentOrderedList<int> list;
+  list.insert(5);
+
+  BOOST_CHECK(!list.insert(5));
+  BOOST_CHECK_EQUAL(list.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenListWithItems_WhenErasing_ThenOnlyThatItemIsGone)
+{
+  aisdi::ConcurrentOrderedList<int> list;
+  for(int i = 0; i != 10; i++)
+    list.insert(i);
+
+  BOOST_CHECK(list.erase(4));
+  BOOST_CHECK(!list.erase(4));
+  BOOST_CHECK(!list.erase(42));
+
+  BOOST_CHECK(!list.contains(4));
+  BOOST_CHECK(list.contains(3));
+  BOOST_CHECK(list.contains(5));
+  BOOST_CHECK_EQUAL(list.getSize(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCustomCompare_WhenInserting_ThenItDecidesEquality)
+{
+  aisdi::ConcurrentOrderedList<int, std::greater<int>> list;
+  list.insert(1);
+  list.insert(3);
+
+  BOOST_CHECK(list.contains(3));
+  BOOST_CHECK(list.erase(1));
+  BOOST_CHECK_EQUAL(list.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenNodesAreRecycledManyTimes_ThenContentsStayCorrect)
+{
+  aisdi::ConcurrentOrderedList<int> list;
+  for(int round = 0; round != 2000; round++)
+  {
+    BOOST_REQUIRE(list.insert(round % 50));
+    BOOST_REQUIRE(list.erase(round % 50));
+  }
+  BOOST_CHECK(list.isEmpty());
+}
+
+// Each thread owns the keys congruent to its index, so it knows exactly what
+// the list must hold for them, while all threads still contend on one list.
+BOOST_AUTO_TEST_CASE(GivenManyThreads_WhenInsertingAndErasingConcurrently_ThenEachSeesItsOwnWrites)
+{
+  const int threads = 8;
+  const int keys = 256;
+  aisdi::ConcurrentOrderedList<int> list;
+  std::atomic<bool> consistent(true);
+
+  std::vector<std::thread> workers;
+  for(int t = 0; t != threads; t++)
+    workers.emplace_back([&list, &consistent, t, threads, keys]()
+    {
+      std::vector<bool> present(keys, false);
+      unsigned state = 2463534242u + t;
+      for(int step = 0; step != 20000; step++)
+      {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        const int slot = (int)(state % (keys / threads));
+        const int key = slot * threads + t;
+        bool ok;
+        if(state % 3 == 0)
+          ok = list.insert(key) == !present[key];
+        else if(state % 3 == 1)
+          ok = list.erase(key) == present[key];
+        else
+          ok = list.contains(key) == present[key];
+        if(state % 3 == 0)
+          present[key] = true;
+        else if(state % 3 == 1)
+          present[key] = false;
+        if(!ok)
+          consistent.store(false);
+      }
+      for(int key = t; key < keys; key += threads)
+        if(list.contains(key) != present[key])
+          consistent.store(false);
+    });
+  for(auto& worker : workers)
+    worker.join();
+
+  BOOST_CHECK(consistent.load());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+#include <ContainerStats.h>
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+using CountedVector = aisdi::Vector<int, aisdi::CountingContainerStats>;
+using CountedList = aisdi::LinkedList<int, aisdi::CountingContainerStats>;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ContainerStatsTests)
+
+BOOST_AUTO_TEST_CASE(GivenVectorWithoutStats_WhenTakingItsSize_ThenThePolicyAddsNothing)
+{
+  BOOST_CHECK_EQUAL(sizeof(aisdi::Vector<int, aisdi::NoContainerStats>), 3 * sizeof(void*));
+  BOOST_CHECK_EQUAL(sizeof(aisdi::LinkedList<int, aisdi::NoContainerStats>), 2 * sizeof(void*));
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorWithoutStats_WhenAskedForStats_ThenOnlyWasteIsReported)
+{
+  aisdi::Vector<int, aisdi::NoContainerStats> vector;
+  for(int i = 0; i != 5; i++)
+    vector.append(i);
+
+  const aisdi::ContainerStats stats = vector.stats();
+
+  BOOST_CHECK_EQUAL(stats.reallocations, 0);
+  BOOST_CHECK_EQUAL(stats.wastedBytes, 3 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenAppendingPastCapacity_ThenReallocationsAreCounted)
+{
+  CountedVector vector;
+  for(int i = 0; i != 5; i++)
+    vector.append(i);
+
+  const aisdi::ContainerStats stats = vector.stats();
+
+  BOOST_CHECK_EQUAL(stats.reallocations, 2);
+  BOOST_CHECK_EQUAL(stats.elementsMoved, 2 + 4);
+  BOOST_CHECK_EQUAL(stats.peakCapacity, 8);
+  BOOST_CHECK_EQUAL(stats.wastedBytes, 3 * sizeof(int));
+  BOOST_CHECK_EQUAL(stats.nodeAllocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenPrependingAndErasing_ThenShiftedElementsAreCounted)
+{
+  CountedVector vector = { 1, 2, 3, 4 };
+  vector.reserve(8);
+  const std::size_t movedByReserve = vector.stats().elementsMoved;
+
+  vector.prepend(0);
+  vector.erase(vector.begin() + 1);
+
+  BOOST_CHECK_EQUAL(movedByReserve, 4);
+  BOOST_CHECK_EQUAL(vector.stats().elementsMoved, 4 + 4 + 3);
+  BOOST_CHECK_EQUAL(vector.stats().reallocations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedVector_WhenCopied_ThenTheCopyStartsWithFreshCounters)
+{
+  CountedVector vector;
+  for(int i = 0; i != 5; i++)
+    vector.append(i);
+
+  const CountedVector copy(vector);
+
+  BOOST_CHECK_EQUAL(copy.stats().reallocations, 0);
+  BOOST_CHECK_EQUAL(copy.stats().peakCapacity, 8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedList_WhenAddingAndErasing_ThenNodeAllocationsAndFreesAreCounted)
+{
+  CountedList list = { 1, 2, 3 };
+  list.append(4);
+  list.popFirst();
+  list.erase(list.begin());
+
+  const aisdi::ContainerStats stats = list.stats();
+
+  BOOST_CHECK_EQUAL(stats.nodeAllocations, 4);
+  BOOST_CHECK_EQUAL(stats.nodeFrees, 2);
+  BOOST_CHECK_EQUAL(stats.peakCapacity, 4);
+  BOOST_CHECK_EQUAL(stats.reallocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCountedContainers_WhenDumpingRegistry_ThenLiveAndDestroyedOnesAreListed)
+{
+  {
+    CountedList list = { 1, 2 };
+  }
+  CountedVector vector = { 1, 2, 3 };
+  vector.append(4);
+
+  std::ostringstream out;
+  aisdi::ContainerStatsRegistry::instance().dump(out);
+  const std::string dump = out.str();
+
+  BOOST_CHECK(dump.find("Vector at ") != std::string::npos);
+  BOOST_CHECK(dump.find("reallocations=1 elementsMoved=3") != std::string::npos);
+  BOOST_CHECK(dump.find(" destroyed LinkedList: ") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#include <FlatMap.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/list.hpp>
+
+// Every lookup test runs with and without the Eytzinger layout.
+using Layouts = boost::mpl::list<boost::mpl::false_, boost::mpl::true_>;
+
+BOOST_AUTO_TEST_SUITE(FlatMapTests)
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::FlatMap<int, std::string> map;
+
+  BOOST_CHECK(map.isEmpty());
+  BOOST_CHECK(!map.contains(1));
+  BOOST_CHECK_EQUAL(map.indexOf(1), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingOutOfOrder_ThenKeysAreSorted,
+                              Layout,
+                              Layouts)
+{
+  aisdi::FlatMap<int, std::string> map;
+  map.useEytzingerLayout(Layout::value);
+
+  BOOST_CHECK(map.insert(30, "c"));
+  BOOST_CHECK(map.insert(10, "a"));
+  BOOST_CHECK(map.insert(20, "b"));
+  BOOST_CHECK(!map.insert(20, "x"));
+
+  BOOST_CHECK_EQUAL(map.getSize(), 3);
+  BOOST_CHECK_EQUAL(map.keyAt(0), 10);
+  BOOST_CHECK_EQUAL(map.keyAt(2), 30);
+  BOOST_CHECK_EQUAL(map.at(20), "b");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenLookingUpEveryKey_ThenResultsMatchStdMap,
+                              Layout,
+                              Layouts)
+{
+  aisdi::FlatMap<int, int> map;
+  std::map<int, int> expected;
+  for(int i = 0; i != 1000; i++)
+    expected[(i * 7919) % 3001] = i;
+  map.insertBulk(expected.begin(), expected.end());
+  map.useEytzingerLayout(Layout::value);
+
+  for(int key = -5; key != 3010; key++)
+  {
+    auto found = expected.find(key);
+    BOOST_REQUIRE_EQUAL(map.contains(key), found != expected.end());
+    if(found != expected.end())
+      BOOST_REQUIRE_EQUAL(map.at(key), found->second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingInBulk_ThenExistingKeysAndFirstDuplicatesWin,
+                              Layout,
+                              Layouts)
+{
+  aisdi::FlatMap<int, std::string> map;
+  map.useEytzingerLayout(Layout::value);
+  map.insert(5, "old");
+  std::pair<int, std::string> items[] = { { 7, "first" }, { 5, "new" }, { 1, "one" }, { 7, "second" } };
+
+  map.insertBulk(std::begin(items), std::end(items));
+
+  BOOST_CHECK_EQUAL(map.getSize(), 3);
+  BOOST_CHECK_EQUAL(map.at(1), "one");
+  BOOST_CHECK_EQUAL(map.at(5), "old");
+  BOOST_CHECK_EQUAL(map.at(7), "first");
+  BOOST_CHECK_EQUAL(map.keys().getSize(), map.values().getSize());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenErasingKey_ThenItIsNoLongerFound,
+                              Layout,
+                              Layouts)
+{
+  aisdi::FlatMap<int, int> map;
+  map.useEytzingerLayout(Layout::value);
+  for(int i = 0; i != 10; i++)
+    map.insert(i, i * i);
+
+  BOOST_CHECK(map.erase(4));
+  BOOST_CHECK(!map.erase(4));
+
+  BOOST_CHECK(!map.contains(4));
+  BOOST_CHECK_EQUAL(map.at(5), 25);
+  BOOST_CHECK_EQUAL(map.getSize(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenAccessingMissingKey_ThenOperationThrows)
+{
+  aisdi::FlatMap<int, int> map;
+  map.insert(1, 1);
+
+  BOOST_CHECK_THROW(map.at(2), std::out_of_range);
+  BOOST_CHECK_THROW(map.keyAt(1), std::out_of_range);
+  BOOST_CHECK_THROW(map.valueAt(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMap_WhenChangingValue_ThenLookupSeesIt)
+{
+  aisdi::FlatMap<std::string, int> map;
+  map.insert("a", 1);
+
+  map.at("a") = 2;
+  map.valueAt(0) += 1;
+
+  BOOST_CHECK_EQUAL(map.at("a"), 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSet_WhenInsertingInBulk_ThenKeysAreSortedAndUnique,
+                              Layout,
+                              Layouts)
+{
+  aisdi::FlatSet<int> set;
+  set.useEytzingerLayout(Layout::value);
+  set.insert(4);
+  int items[] = { 9, 4, 1, 9, 6 };
+  int expected[] = { 1, 4, 6, 9 };
+
+  set.insertBulk(std::begin(items), std::end(items));
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(set.begin(), set.end(), std::begin(expected), std::end(expected));
+  BOOST_CHECK(set.contains(6));
+  BOOST_CHECK(!set.contains(5));
+  BOOST_CHECK(!set.contains(10));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSet_WhenInsertingAndErasing_ThenMembershipIsUpdated)
+{
+  aisdi::FlatSet<int> set;
+
+  BOOST_CHECK(set.insert(2));
+  BOOST_CHECK(!set.insert(2));
+  BOOST_CHECK(set.erase(2));
+  BOOST_CHECK(!set.erase(2));
+
+  BOOST_CHECK(set.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <Footprint.h>
+#include <MemorySweep.h>
+
+#include <fstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include "TemporaryFile.h"
+
+namespace
+{
+
+struct RollupFile : TemporaryFile
+{
+  RollupFile()
+    : TemporaryFile("aisdi_footprint_test_rollup")
+  {}
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FootprintTests)
+
+BOOST_FIXTURE_TEST_CASE(GivenRollup_WhenReading_ThenRssAndPssAreInBytes, RollupFile)
+{
+  std::ofstream(path.c_str())<<"55d0c4a00000-7ffd5b5fe000 ---p 00000000 00:00 0    [rollup]\n"
+                               "Rss:                1304 kB\n"
+                               "Pss:                 389 kB\n"
+                               "Pss_Anon:            100 kB\n";
+
+  const aisdi::bench::ProcessMemory memory = aisdi::bench::readProcessMemory(path);
+
+  BOOST_CHECK_EQUAL(memory.rss, 1304 * 1024);
+  BOOST_CHECK_EQUAL(memory.pss, 389 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoRollup_WhenReading_ThenRssStillComesFromStatm)
+{
+  const aisdi::bench::ProcessMemory memory = aisdi::bench::readProcessMemory("aisdi_footprint_test_missing");
+
+  BOOST_CHECK(memory.rss > 0);
+  BOOST_CHECK_EQUAL(memory.pss, -1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedList_WhenMeasuring_ThenEveryNodeIsOneAllocationOfItsChunk)
+{
+  const aisdi::bench::Footprint footprint =
+    aisdi::bench::measureFootprint<aisdi::LinkedList<int>>("LinkedList", "int", 1000);
+
+  const long long node = (long long)aisdi::bench::listNodeBytes<int>();
+  // the nodes, the sentinel and the list itself; malloc may hand out
+  // bigger chunks left free by earlier tests, so only bounds are exact
+  BOOST_CHECK_EQUAL(footprint.allocations, 1002);
+  BOOST_CHECK(footprint.heapBytes >= 1000 * node);
+  BOOST_CHECK_EQUAL(footprint.keptSize, 250);
+  BOOST_CHECK(footprint.heapBytes - footprint.keptHeapBytes >= 750 * node);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenMeasuring_ThenSlackCapacityStaysAfterErasing)
+{
+  const aisdi::bench::Footprint footprint =
+    aisdi::bench::measureFootprint<aisdi::Vector<int>>("Vector", "int", 1000);
+
+  BOOST_CHECK(footprint.heapBytes >= (long long)(1000 * sizeof(int)));
+  BOOST_CHECK(footprint.peakHeapBytes > footprint.heapBytes);
+  BOOST_CHECK_EQUAL(footprint.keptHeapBytes, footprint.heapBytes);
+}
+
+BOOST_AUTO_TEST_CASE(GivenResidentMemoryAboveHeap_WhenComputingFragmentation_ThenTheUnusedShareIsReturned)
+{
+  aisdi::bench::Footprint footprint;
+  footprint.keptHeapBytes = 250;
+  footprint.keptRssDelta = 1000;
+  BOOST_CHECK_CLOSE(aisdi::bench::fragmentation(footprint), 0.75, 1e-9);
+
+  footprint.keptRssDelta = 0;
+  BOOST_CHECK_EQUAL(aisdi::bench::fragmentation(footprint), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include <Benchmark.h>
+#include <LatencyHistogram.h>
+#include <LinearBenchmarks.h>
+#include <Vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using aisdi::bench::LatencyHistogram;
+
+BOOST_AUTO_TEST_SUITE(LatencyHistogramTests)
+
+BOOST_AUTO_TEST_CASE(GivenEmptyHistogram_WhenAskedForPercentiles_ThenZeroIsReturned)
+{
+  const LatencyHistogram histogram;
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 0);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(99), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallValues_WhenRecorded_ThenPercentilesAreExact)
+{
+  LatencyHistogram histogram;
+  for(std::uint64_t value = 1; value <= 50; value++)
+    histogram.record(value);
+
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(50), 25);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(90), 45);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(100), 50);
+  BOOST_CHECK_EQUAL(histogram.getMin(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAnyValue_WhenIndexed_ThenItsBucketHoldsItWithin1Of32)
+{
+  const std::uint64_t values[] = { 0, 63, 64, 65, 127, 128, 1000, 123456789, ~std::uint64_t(0) };
+  for(std::uint64_t value : values)
+  {
+    const std::size_t index = LatencyHistogram::indexOf(value);
+    const std::size_t buckets = LatencyHistogram::bucketCount;
+    BOOST_REQUIRE(index < buckets);
+    BOOST_CHECK(LatencyHistogram::lowestValueAt(index) <= value);
+    BOOST_CHECK(LatencyHistogram::highestValueAt(index) >= value);
+    BOOST_CHECK(LatencyHistogram::highestValueAt(index) - LatencyHistogram::lowestValueAt(index) <= value / 32);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenRareSpikes_WhenRecorded_ThenOnlyTheTailPercentilesShowThem)
+{
+  LatencyHistogram histogram;
+  for(int i = 0; i != 990; i++)
+    histogram.record(20);
+  for(int i = 0; i != 10; i++)
+    histogram.record(100000);
+
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(50), 20);
+  BOOST_CHECK_EQUAL(histogram.valueAtPercentile(99), 20);
+  BOOST_CHECK(histogram.valueAtPercentile(99.9) >= 100000);
+  BOOST_CHECK(histogram.valueAtPercentile(99.9) <= 100000 + 100000 / 32);
+  BOOST_CHECK_EQUAL(histogram.getMax(), 100000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoHistograms_WhenMerged_ThenCountsAndExtremesAreCombined)
+{
+  LatencyHistogram first;
+  LatencyHistogram second;
+  first.record(10);
+  second.record(5);
+  second.record(5000);
+
+  first += second;
+
+  BOOST_CHECK_EQUAL(first.getCount(), 3);
+  BOOST_CHECK_EQUAL(first.getMin(), 5);
+  BOOST_CHECK_EQUAL(first.getMax(), 5000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLatenciesOption_WhenRunningCase_ThenEveryTimedOperationIsRecorded)
+{
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerLinearBenchmarks<aisdi::Vector<int>>(registry, "Vector", "int");
+  const char* argv[] = { "aisdiBenchmarks", "--latencies", "--repetitions=3", "--filter=append/*",
+                         "--sizes=100" };
+  aisdi::bench::Options options = aisdi::bench::parseOptions(5, argv);
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+
+  BOOST_REQUIRE_EQUAL(results.getSize(), 1);
+  BOOST_REQUIRE(aisdi::bench::hasLatencies(*results.begin()));
+  BOOST_CHECK_EQUAL((*results.begin()).latencies->getCount(), 3 * 100);
+
+  std::ostringstream out;
+  aisdi::bench::writeHistograms(out, results);
+  BOOST_CHECK(out.str().find("append,Vector,int,100,") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
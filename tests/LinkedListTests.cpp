@@ -932,6 +932,43 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIf_ThenMatchingItemsAreRemovedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 2, 5, 2 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(2); });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  thenCollectionContainsValues(collection, { 1, 3, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIfNothingMatches_ThenCollectionIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(42); });
+
+  BOOST_CHECK_EQUAL(removed, 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIfEverythingMatches_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  collection.removeIf([](const T&) { return true; });
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
@@ -0,0 +1,122 @@
+#include <MappedVector.h>
+#include <Vector.h>
+
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "TemporaryFile.h"
+
+namespace
+{
+
+struct MappedVectorFile : TemporaryFile
+{
+  MappedVectorFile()
+    : TemporaryFile("aisdi_mapped_vector_test.bin")
+  {}
+};
+
+}
+
+using MappedTestedTypes = boost::mpl::list<std::int32_t,
+                                           std::uint64_t,
+                                           std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(MappedVectorTests, MappedVectorFile)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSavedVector_WhenMapping_ThenAllItemsAreInView,
+                              T,
+                              MappedTestedTypes)
+{
+  aisdi::Vector<T> collection = { 4, 8, 15, 16, 23, 42 };
+
+  collection.saveTo(path);
+  aisdi::MappedVector<T> mapped(path);
+
+  BOOST_CHECK_EQUAL(mapped.getSize(), 6);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(mapped), end(mapped), begin(collection), end(collection));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedEmptyVector_WhenMapping_ThenViewIsEmpty)
+{
+  aisdi::Vector<int> collection;
+
+  collection.saveTo(path);
+  aisdi::MappedVector<int> mapped(path);
+
+  BOOST_CHECK(mapped.isEmpty());
+  BOOST_CHECK(mapped.begin() == mapped.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeSavedVector_WhenMapping_ThenPayloadIsAligned)
+{
+  aisdi::Vector<std::uint64_t> collection;
+  for(std::uint64_t i = 0; i != 100000; i++)
+    collection.append(i * i);
+
+  collection.saveTo(path);
+  aisdi::MappedVector<std::uint64_t> mapped(path);
+
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(mapped.data()) % alignof(std::uint64_t), 0);
+  BOOST_CHECK_EQUAL(mapped[99999], 99999ull * 99999ull);
+  BOOST_CHECK_EQUAL(*(mapped.end() - 1), 99999ull * 99999ull);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSavedVector_WhenMappingAsOtherType_ThenOperationThrows)
+{
+  aisdi::Vector<std::int32_t> collection = { 1, 2 };
+
+  collection.saveTo(path);
+
+  BOOST_CHECK_THROW(aisdi::MappedVector<std::uint32_t> mapped(path), std::runtime_error);
+  BOOST_CHECK_THROW(aisdi::MappedVector<std::uint64_t> mapped(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMissingFile_WhenMapping_ThenOperationThrows)
+{
+  BOOST_CHECK_THROW(aisdi::MappedVector<int> mapped("aisdi_no_such_file.bin"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedFile_WhenMapping_ThenOperationThrows)
+{
+  aisdi::Vector<std::uint64_t> collection = { 1, 2, 3 };
+  collection.saveTo(path);
+  BOOST_REQUIRE_EQUAL(truncate(path.c_str(), 64 + 8), 0);
+
+  BOOST_CHECK_THROW(aisdi::MappedVector<std::uint64_t> mapped(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMappedVector_WhenIteratingPastEnd_ThenOperationThrows)
+{
+  aisdi::Vector<int> collection = { 1 };
+  collection.saveTo(path);
+  aisdi::MappedVector<int> mapped(path);
+
+  BOOST_CHECK_THROW(*mapped.end(), std::out_of_range);
+  BOOST_CHECK_THROW(mapped.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(mapped.begin()--, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMappedVector_WhenMoving_ThenViewIsTransferred)
+{
+  aisdi::Vector<int> collection = { 7, 9 };
+  collection.saveTo(path);
+  aisdi::MappedVector<int> mapped(path);
+
+  aisdi::MappedVector<int> other(std::move(mapped));
+
+  BOOST_CHECK(mapped.isEmpty());
+  BOOST_CHECK_EQUAL(other[1], 9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
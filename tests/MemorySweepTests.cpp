@@ -0,0 +1,172 @@
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <Benchmark.h>
+#include <MemorySweep.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+// A sysfs-like cache directory with the given index directories, removed
+// again even when a check throws.
+struct FakeCacheDirectory
+{
+  std::string root;
+  aisdi::Vector<std::string> files;
+  aisdi::Vector<std::string> directories;
+
+  FakeCacheDirectory()
+    : root("aisdi_memory_sweep_test_cache")
+  {
+    makeDirectory(root);
+  }
+
+  ~FakeCacheDirectory()
+  {
+    for(const std::string& file : files)
+      std::remove(file.c_str());
+    for(auto directory = directories.end(); directory != directories.begin(); )
+      rmdir((*--directory).c_str());
+  }
+
+  void makeDirectory(const std::string& path)
+  {
+    mkdir(path.c_str(), 0755);
+    directories.append(path);
+  }
+
+  void addCache(unsigned index, const std::string& level, const std::string& type, const std::string& size)
+  {
+    const std::string directory = root + "/index" + std::to_string(index);
+    makeDirectory(directory);
+    writeFile(directory + "/level", level);
+    writeFile(directory + "/type", type);
+    writeFile(directory + "/size", size);
+  }
+
+  void writeFile(const std::string& path, const std::string& contents)
+  {
+    std::ofstream(path.c_str())<<contents<<"\n";
+    files.append(path);
+  }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MemorySweepTests)
+
+BOOST_AUTO_TEST_CASE(GivenSysfsSizes_WhenParsing_ThenBytesAreReturned)
+{
+  BOOST_CHECK_EQUAL(aisdi::bench::parseCacheSize("48K"), 48 * 1024);
+  BOOST_CHECK_EQUAL(aisdi::bench::parseCacheSize("32M"), 32 * 1024 * 1024);
+  BOOST_CHECK_EQUAL(aisdi::bench::parseCacheSize("512"), 512);
+  BOOST_CHECK_EQUAL(aisdi::bench::parseCacheSize("12Q"), 0);
+  BOOST_CHECK_EQUAL(aisdi::bench::parseCacheSize("K"), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(GivenCacheDirectory_WhenDetecting_ThenDataCachesAreReturnedByLevel,
+                        FakeCacheDirectory)
+{
+  addCache(0, "2", "Unified", "1024K");
+  addCache(1, "1", "Instruction", "32K");
+  addCache(2, "1", "Data", "48K");
+
+  const aisdi::Vector<aisdi::bench::CacheLevel> caches = aisdi::bench::detectDataCaches(root);
+
+  BOOST_REQUIRE_EQUAL(caches.getSize(), 2);
+  BOOST_CHECK_EQUAL((*caches.begin()).level, 1);
+  BOOST_CHECK_EQUAL((*caches.begin()).bytes, 48 * 1024);
+  BOOST_CHECK_EQUAL((*(caches.begin() + 1)).level, 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoCacheDirectory_WhenDetecting_ThenNothingIsFound)
+{
+  BOOST_CHECK(aisdi::bench::detectDataCaches("aisdi_memory_sweep_test_missing").isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenCaches_WhenChoosingTiers_ThenEachGetsHalfAndDramFourTimesTheLast)
+{
+  const aisdi::Vector<aisdi::bench::CacheLevel> caches = { { 1, 32 << 10 }, { 2, 1 << 20 }, { 3, 8 << 20 } };
+
+  const aisdi::Vector<aisdi::bench::MemoryTier> tiers = aisdi::bench::memoryTiers(caches);
+
+  BOOST_REQUIRE_EQUAL(tiers.getSize(), 4);
+  BOOST_CHECK_EQUAL((*tiers.begin()).name, "L1");
+  BOOST_CHECK_EQUAL((*tiers.begin()).workingSetBytes, 16 << 10);
+  BOOST_CHECK_EQUAL((*(tiers.begin() + 3)).name, "DRAM");
+  BOOST_CHECK_EQUAL((*(tiers.begin() + 3)).workingSetBytes, 32 << 20);
+}
+
+BOOST_AUTO_TEST_CASE(GivenHugeLastCache_WhenChoosingTiers_ThenDramIsTwiceIt)
+{
+  const aisdi::Vector<aisdi::bench::CacheLevel> caches = { { 3, 200 << 20 } };
+
+  const aisdi::Vector<aisdi::bench::MemoryTier> tiers = aisdi::bench::memoryTiers(caches);
+
+  BOOST_CHECK_EQUAL((*(tiers.begin() + 1)).workingSetBytes, 400 << 20);
+}
+
+BOOST_AUTO_TEST_CASE(GivenScatteredFill_WhenWalkingList_ThenNeighboursAreRarelyAdjacent)
+{
+  aisdi::LinkedList<int> ordered;
+  aisdi::bench::fill(ordered, 10000);
+  aisdi::LinkedList<int> scattered;
+  aisdi::bench::fillScattered(scattered, 10000);
+
+  BOOST_CHECK_EQUAL(scattered.getSize(), 10000);
+  BOOST_CHECK_EQUAL(*scattered.begin(), 0);
+  BOOST_CHECK(aisdi::bench::adjacentFraction(ordered) > 0.9);
+  BOOST_CHECK_EQUAL(*(--scattered.end()), 9999);
+  // scattering is best effort: it takes glibc's last in, first out reuse,
+  // which a sanitizer's allocator doesn't do
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+  BOOST_CHECK(aisdi::bench::adjacentFraction(scattered) < 0.1);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(GivenScatterChecks_WhenRunningShuffledNodes_ThenEveryWorkingSetGetsOne)
+{
+  aisdi::bench::Registry registry;
+  aisdi::Vector<aisdi::bench::ScatterCheck> checks;
+  aisdi::bench::registerMemorySweep<int>(registry, "int", &checks);
+  aisdi::bench::Options options;
+  options.filters = { "shuffled-node/*" };
+  options.sizes = { 4096, 8192 };
+  options.repetitions = 2;
+  options.minSampleMicroseconds = 0;
+
+  aisdi::bench::runSelected(registry, options);
+
+  BOOST_REQUIRE_EQUAL(checks.getSize(), 2);
+  BOOST_CHECK_EQUAL((*checks.begin()).workingSetBytes, 4096);
+  BOOST_CHECK_EQUAL((*(checks.begin() + 1)).workingSetBytes, 8192);
+  BOOST_CHECK((*checks.begin()).adjacentFraction >= 0 and (*checks.begin()).adjacentFraction <= 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSweep_WhenRunning_ThenEveryTraversalCountsItsElements)
+{
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerMemorySweep<int>(registry, "int");
+  aisdi::bench::Options options;
+  options.sizes = { 4096 };
+  options.repetitions = 1;
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+
+  BOOST_CHECK_EQUAL(results.getSize(), 4);
+  for(const aisdi::bench::Result& result : results)
+    BOOST_CHECK(result.nanosecondsPerOperation.median > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include <MpmcQueue.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(MpmcQueueTests)
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenCreated_ThenItIsEmptyWithPowerOfTwoCapacity)
+{
+  const aisdi::MpmcQueue<int> queue(5);
+
+  BOOST_CHECK(queue.isEmpty());
+  BOOST_CHECK_EQUAL(queue.getCapacity(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenZeroCapacity_WhenCreatingQueue_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(aisdi::MpmcQueue<int> queue(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyQueue_WhenPopping_ThenNothingIsReturned)
+{
+  aisdi::MpmcQueue<int> queue(4);
+  int item = 7;
+
+  BOOST_CHECK(!queue.tryPop(item));
+  BOOST_CHECK_EQUAL(item, 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenPushingAndPopping_ThenItemsComeOutInOrder)
+{
+  aisdi::MpmcQueue<std::string> queue(4);
+
+  BOOST_CHECK(queue.tryPush("a"));
+  BOOST_CHECK(queue.tryPush("b"));
+  BOOST_CHECK_EQUAL(queue.getSize(), 2);
+
+  std::string item;
+  BOOST_CHECK(queue.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "a");
+  BOOST_CHECK(queue.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "b");
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullQueue_WhenPushing_ThenItemIsRejectedUntilSomethingIsPopped)
+{
+  aisdi::MpmcQueue<int> queue(4);
+  for(int i = 0; i != 4; i++)
+    BOOST_REQUIRE(queue.tryPush(i));
+
+  BOOST_CHECK(!queue.tryPush(4));
+
+  int item;
+  BOOST_CHECK(queue.tryPop(item));
+  BOOST_CHECK_EQUAL(item, 0);
+  BOOST_CHECK(queue.tryPush(4));
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueue_WhenCellsAreReusedManyLaps_ThenOrderIsKept)
+{
+  aisdi::MpmcQueue<int> queue(2);
+  int expected = 0;
+  for(int i = 0; i != 1000; i++)
+  {
+    BOOST_REQUIRE(queue.tryPush(i));
+    int item;
+    BOOST_REQUIRE(queue.tryPop(item));
+    BOOST_REQUIRE_EQUAL(item, expected++);
+  }
+}
+
+// Every item is popped exactly once, and items of one producer reach any
+// single consumer in the order they were pushed - what a FIFO must preserve.
+BOOST_AUTO_TEST_CASE(GivenManyProducersAndConsumers_WhenTransferring_ThenQueueBehavesLikeFifo)
+{
+  const int producers = 4;
+  const int consumers = 4;
+  const int perProducer = 50000;
+  aisdi::MpmcQueue<int> queue(64);
+  std::vector<std::atomic<int>> seen(producers * perProducer);
+  for(auto& count : seen)
+    count.store(0);
+  std::atomic<int> remaining(producers * perProducer);
+  std::atomic<bool> ordered(true);
+
+  std::vector<std::thread> threads;
+  for(int p = 0; p != producers; p++)
+    threads.emplace_back([&queue, p, perProducer]()
+    {
+      for(int i = 0; i != perProducer; i++)
+        while(!queue.tryPush(p * perProducer + i))
+          std::this_thread::yield();
+    });
+  for(int c = 0; c != consumers; c++)
+    threads.emplace_back([&]()
+    {
+      std::vector<int> last(producers, -1);
+      while(remaining.load() > 0)
+      {
+        int item;
+        if(!queue.tryPop(item))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        remaining--;
+        seen[item]++;
+        const int producer = item / perProducer;
+        if(item % perProducer <= last[producer])
+          ordered.store(false);
+        last[producer] = item % perProducer;
+      }
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  bool exactlyOnce = true;
+  for(auto& count : seen)
+    exactlyOnce = exactlyOnce and count.load() == 1;
+  BOOST_CHECK(exactlyOnce);
+  BOOST_CHECK(ordered.load());
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+#include <PackedVector.h>
+
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/int.hpp>
+
+using PackedWidths = boost::mpl::list<boost::mpl::int_<1>,
+                                      boost::mpl::int_<7>,
+                                      boost::mpl::int_<20>,
+                                      boost::mpl::int_<33>,
+                                      boost::mpl::int_<64>>;
+
+namespace
+{
+
+std::uint64_t patternValue(std::size_t index, unsigned bits)
+{
+  std::uint64_t value = (index * 0x9E3779B97F4A7C15ull) ^ (index >> 3);
+  return value & aisdi::detail::lowBitsMask(bits);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PackedVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::PackedVector<20> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_EQUAL(collection.getBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingItems_ThenEveryItemIsReadBack,
+                              Width,
+                              PackedWidths)
+{
+  const unsigned bits = Width::value;
+  aisdi::PackedVector<Width::value> collection;
+
+  for(std::size_t i = 0; i != 1000; i++)
+    collection.append(patternValue(i, bits));
+
+  BOOST_REQUIRE_EQUAL(collection.getSize(), 1000);
+  for(std::size_t i = 0; i != 1000; i++)
+    BOOST_REQUIRE_EQUAL(collection[i], patternValue(i, bits));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenUnpackingUnalignedRange_ThenValuesMatchIndexing,
+                              Width,
+                              PackedWidths)
+{
+  const unsigned bits = Width::value;
+  aisdi::PackedVector<Width::value> collection;
+  for(std::size_t i = 0; i != 1000; i++)
+    collection.append(patternValue(i, bits));
+  std::uint64_t out[1000];
+
+  collection.unpack(13, 900, out);
+
+  for(std::size_t i = 0; i != 900; i++)
+    BOOST_REQUIRE_EQUAL(out[i], patternValue(i + 13, bits));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSettingItem_ThenNeighboursAreUnchanged,
+                              Width,
+                              PackedWidths)
+{
+  const unsigned bits = Width::value;
+  aisdi::PackedVector<Width::value> collection;
+  for(std::size_t i = 0; i != 200; i++)
+    collection.append(patternValue(i, bits));
+
+  for(std::size_t i = 0; i < 200; i += 3)
+    collection.set(i, aisdi::detail::lowBitsMask(bits));
+
+  for(std::size_t i = 0; i != 200; i++)
+    BOOST_REQUIRE_EQUAL(collection[i], i % 3 == 0 ? aisdi::detail::lowBitsMask(bits)
+                                                  : patternValue(i, bits));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenAppendingTooWideValue_ThenOperationThrows)
+{
+  aisdi::PackedVector<20> collection;
+
+  BOOST_CHECK_THROW(collection.append(std::uint64_t(1) << 20), std::out_of_range);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenPoppingLast_ThenLastItemIsReturned)
+{
+  aisdi::PackedVector<20> collection = { 1, 2, 3 };
+
+  BOOST_CHECK_EQUAL(collection.popLast(), 3);
+  collection.append(7);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  BOOST_CHECK_EQUAL(collection[2], 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows)
+{
+  aisdi::PackedVector<20> collection;
+
+  BOOST_CHECK_THROW(collection.popLast(), std::out_of_range);
+  BOOST_CHECK_THROW(collection.at(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPackedIds_WhenMeasuringBytes_ThenTheyUseFractionOfFullWords)
+{
+  aisdi::PackedVector<20> collection;
+  for(std::size_t i = 0; i != 64 * 100; i++)
+    collection.append(i);
+
+  BOOST_CHECK_LE(collection.getBytes(), 64 * 100 * 20 / 8 * 2);
+  BOOST_CHECK_EQUAL(*(++collection.begin()), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPackedBlockOfEveryWidth_WhenUnpacking_ThenSelectedAndScalarKernelsAgree)
+{
+  const aisdi::detail::BlockKernels& kernels = aisdi::detail::BlockKernels::instance();
+  for(unsigned bits = 0; bits <= 64; bits++)
+  {
+    std::uint64_t values[64];
+    for(std::size_t i = 0; i != 64; i++)
+      values[i] = patternValue(i, bits);
+    // exactly bits words, for sanitizers to catch a kernel reading past them
+    std::uint64_t* words = new std::uint64_t[bits];
+    kernels.pack[bits](values, words);
+    std::uint64_t scalar[64];
+    std::uint64_t selected[64];
+
+    kernels.scalarUnpack[bits](words, scalar);
+    kernels.unpack[bits](words, selected);
+
+    for(std::size_t i = 0; i != 64; i++)
+    {
+      BOOST_REQUIRE_EQUAL(scalar[i], values[i]);
+      BOOST_REQUIRE_EQUAL(selected[i], values[i]);
+    }
+    delete [] words;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#include <AllocationCounter.h>
+#include <Benchmark.h>
+#include <LinearBenchmarks.h>
+#include <LinkedList.h>
+#include <Payloads.h>
+#include <Vector.h>
+
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using PayloadTypes = boost::mpl::list<aisdi::bench::TrivialPayload<4>, aisdi::bench::TrivialPayload<1024>,
+                                      aisdi::bench::OwningPayload<4>, aisdi::bench::OwningPayload<1024>>;
+
+BOOST_AUTO_TEST_SUITE(PayloadsTests)
+
+BOOST_AUTO_TEST_CASE(GivenTrivialPayload_WhenStored_ThenItTakesExactlyItsBytes)
+{
+  BOOST_CHECK_EQUAL(sizeof(aisdi::bench::TrivialPayload<4>), 4);
+  BOOST_CHECK_EQUAL(sizeof(aisdi::bench::TrivialPayload<256>), 256);
+  BOOST_CHECK_EQUAL(sizeof(aisdi::bench::OwningPayload<256>), sizeof(void*));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenElementMadeFromIndex_WhenReadingId_ThenIndexIsBack,
+                              Payload,
+                              PayloadTypes)
+{
+  const Payload payload = aisdi::bench::makeElement<Payload>(1234);
+  const Payload copy = payload;
+
+  BOOST_CHECK_EQUAL(payload.getId(), 1234);
+  BOOST_CHECK_EQUAL(copy.getId(), 1234);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOwningPayload_WhenCopied_ThenItAllocatesItsOwnBuffer)
+{
+  const aisdi::bench::OwningPayload<64> payload(7);
+  aisdi::bench::OwningPayload<64> full(8);
+
+  aisdi::bench::AllocationCounter counter;
+  aisdi::bench::OwningPayload<64> copy = payload;
+  full = payload;
+  const aisdi::bench::AllocationCounts& counts = counter.stop();
+
+  BOOST_CHECK_EQUAL(counts.allocations, 1);
+  BOOST_CHECK_EQUAL(counts.bytes, 64);
+  BOOST_CHECK_EQUAL(copy.getId(), 7);
+  BOOST_CHECK_EQUAL(full.getId(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOwningPayload_WhenMoved_ThenBufferIsStolen)
+{
+  aisdi::bench::OwningPayload<64> payload(7);
+
+  aisdi::bench::AllocationCounter counter;
+  aisdi::bench::OwningPayload<64> moved = std::move(payload);
+  const aisdi::bench::AllocationCounts& counts = counter.stop();
+
+  BOOST_CHECK_EQUAL(counts.allocations, 0);
+  BOOST_CHECK_EQUAL(moved.getId(), 7);
+  BOOST_CHECK(payload.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenOwningPayload_WhenMoveAssigned_ThenOldBufferIsFreedAndSourceIsEmpty)
+{
+  aisdi::bench::OwningPayload<64> payload(7);
+  aisdi::bench::OwningPayload<64> target(8);
+
+  aisdi::bench::AllocationCounter counter;
+  target = std::move(payload);
+  const aisdi::bench::AllocationCounts& counts = counter.stop();
+
+  BOOST_CHECK_EQUAL(counts.allocations, 0);
+  BOOST_CHECK_EQUAL(counts.frees, 1);
+  BOOST_CHECK_EQUAL(target.getId(), 7);
+  BOOST_CHECK(payload.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenPayloadContainers_WhenRunningLinearBenchmarks_ThenEveryOneCompletes)
+{
+  using aisdi::bench::OwningPayload;
+  using aisdi::bench::TrivialPayload;
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerLinearBenchmarks<aisdi::Vector<TrivialPayload<64>>>(registry, "Vector", "pod64");
+  aisdi::bench::registerLinearBenchmarks<aisdi::LinkedList<OwningPayload<64>>>(registry, "LinkedList", "own64");
+  aisdi::bench::Options options;
+  options.sizes = { 100 };
+  options.repetitions = 1;
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+
+  BOOST_CHECK_EQUAL(results.getSize(), 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+#include <PersistentVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using PersistentCollection = aisdi::PersistentVector<T>;
+
+using PersistentTestedTypes = boost::mpl::list<std::int32_t,
+                                               std::uint64_t,
+                                               std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(PersistentVectorTests)
+
+template <typename T>
+void thenCollectionContainsValues(const PersistentCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+template <typename T>
+void thenCollectionContainsRange(const PersistentCollection<T>& collection, int first, int count)
+{
+  BOOST_REQUIRE_EQUAL(collection.getSize(), static_cast<std::size_t>(count));
+  for(int i = 0; i != count; i++)
+    BOOST_REQUIRE(collection[i] == T(first + i));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              PersistentTestedTypes)
+{
+  const PersistentCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInitializingFromList_ThenAllItemsAreInCollection,
+                              T,
+                              PersistentTestedTypes)
+{
+  const PersistentCollection<T> collection = { 1, 2, 3, 4 };
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppending_ThenOriginalIsUnchanged,
+                              T,
+                              PersistentTestedTypes)
+{
+  const PersistentCollection<T> collection = { 1, 2 };
+
+  auto next = collection.append(T{3});
+
+  thenCollectionContainsValues(collection, { 1, 2 });
+  thenCollectionContainsValues(next, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingManyItems_ThenAllAreIndexable,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> collection;
+
+  // crosses the tail, first trie level and second trie level boundaries
+  for(int i = 0; i != 40000; i++)
+    collection = collection.append(T(i));
+
+  thenCollectionContainsRange(collection, 0, 40000);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSettingItem_ThenOnlyNewVersionChanges,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> collection;
+  for(int i = 0; i != 2000; i++)
+    collection = collection.append(T(i));
+
+  auto inTrie = collection.set(5, T(-1));
+  auto inTail = collection.set(1999, T(-2));
+
+  BOOST_CHECK(collection[5] == T(5));
+  BOOST_CHECK(collection[1999] == T(1999));
+  BOOST_CHECK(inTrie[5] == T(-1));
+  BOOST_CHECK(inTail[1999] == T(-2));
+  BOOST_CHECK(inTrie[1999] == T(1999));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSettingOutOfRange_ThenOperationThrows,
+                              T,
+                              PersistentTestedTypes)
+{
+  const PersistentCollection<T> collection = { 1, 2 };
+
+  BOOST_CHECK_THROW(collection.set(2, T{}), std::out_of_range);
+  BOOST_CHECK_THROW(collection.at(2), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows,
+                              T,
+                              PersistentTestedTypes)
+{
+  const PersistentCollection<T> collection;
+
+  BOOST_CHECK_THROW(collection.popLast(), std::out_of_range);
+  BOOST_CHECK_THROW(collection.last(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenPoppingAll_ThenEveryVersionIsConsistent,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> collection;
+  for(int i = 0; i != 1100; i++)
+    collection = collection.append(T(i));
+  const auto original = collection;
+
+  for(int i = 1100; i != 0; i--)
+  {
+    BOOST_REQUIRE(collection.last() == T(i - 1));
+    collection = collection.popLast();
+  }
+
+  BOOST_CHECK(collection.isEmpty());
+  thenCollectionContainsRange(original, 0, 1100);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenPoppedCollection_WhenAppendingAgain_ThenItemsAreIndexable,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> collection;
+  for(int i = 0; i != 1057; i++)
+    collection = collection.append(T(i));
+  for(int i = 0; i != 40; i++)
+    collection = collection.popLast();
+  for(int i = 1017; i != 1100; i++)
+    collection = collection.append(T(i));
+
+  thenCollectionContainsRange(collection, 0, 1100);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTransient_WhenBuildingInBulk_ThenSourceIsUnchanged,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> source;
+  for(int i = 0; i != 100; i++)
+    source = source.append(T(i));
+
+  auto builder = source.transient();
+  for(int i = 100; i != 5000; i++)
+    builder.append(T(i));
+  builder.set(3, T(-3));
+  auto built = builder.persistent();
+
+  thenCollectionContainsRange(source, 0, 100);
+  BOOST_CHECK_EQUAL(built.getSize(), 5000);
+  BOOST_CHECK(built[3] == T(-3));
+  BOOST_CHECK(built[4999] == T(4999));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTransient_WhenModifiedAfterPersistent_ThenFrozenVersionIsUnchanged,
+                              T,
+                              PersistentTestedTypes)
+{
+  auto builder = PersistentCollection<T>().transient();
+  for(int i = 0; i != 100; i++)
+    builder.append(T(i));
+  auto frozen = builder.persistent();
+
+  builder.set(0, T(-1));
+  builder.set(99, T(-1));
+  builder.popLast();
+  builder.append(T(-2));
+
+  thenCollectionContainsRange(frozen, 0, 100);
+  BOOST_CHECK(builder[0] == T(-1));
+  BOOST_CHECK(builder[99] == T(-2));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenMovingAcrossLeaves_ThenItemsAreReturned,
+                              T,
+                              PersistentTestedTypes)
+{
+  PersistentCollection<T> collection;
+  for(int i = 0; i != 100; i++)
+    collection = collection.append(T(i));
+
+  auto it = collection.begin() + 31;
+  BOOST_CHECK(*it == T(31));
+  ++it;
+  BOOST_CHECK(*it == T(32));
+  --it;
+  --it;
+  BOOST_CHECK(*it == T(30));
+  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+  BOOST_CHECK_THROW(collection.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(collection.begin()--, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionOfStrings_WhenSharingVersions_ThenValuesAreIndependent)
+{
+  PersistentCollection<std::string> collection = { "a", "b", "c" };
+
+  auto changed = collection.set(1, "x");
+
+  BOOST_CHECK_EQUAL(collection[1], "b");
+  BOOST_CHECK_EQUAL(changed[1], "x");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
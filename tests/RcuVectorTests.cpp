@@ -0,0 +1,123 @@
+#include <RcuVector.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(RcuVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenRcuVector_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const aisdi::RcuVector<int> vector;
+
+  BOOST_CHECK(vector.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenRcuVectorCreatedFromVector_WhenReading_ThenItemsAreTheSame)
+{
+  const aisdi::RcuVector<std::string> vector(aisdi::Vector<std::string>{ "a", "b" });
+
+  aisdi::RcuVector<std::string>::Snapshot snapshot(vector);
+  BOOST_CHECK_EQUAL(snapshot->getSize(), 2);
+  BOOST_CHECK_EQUAL(*snapshot->begin(), "a");
+  BOOST_CHECK_EQUAL(*(snapshot->begin() + 1), "b");
+}
+
+BOOST_AUTO_TEST_CASE(GivenRcuVector_WhenUpdating_ThenNewReadersSeeTheChange)
+{
+  aisdi::RcuVector<int> vector;
+
+  vector.update([](aisdi::Vector<int>& items)
+  {
+    items.append(1);
+    items.append(2);
+  });
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 2);
+  BOOST_CHECK_EQUAL(vector.read([](const aisdi::Vector<int>& items) { return items.data()[1]; }), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOpenSnapshot_WhenUpdating_ThenSnapshotKeepsOldVersion)
+{
+  aisdi::RcuVector<int> vector(aisdi::Vector<int>{ 1, 2, 3 });
+  aisdi::RcuVector<int>::Snapshot snapshot(vector);
+
+  for(int i = 0; i != 10; i++)
+    vector.update([](aisdi::Vector<int>& items) { items.data()[0]++; });
+
+  BOOST_CHECK_EQUAL(snapshot->data()[0], 1);
+  BOOST_CHECK_EQUAL(vector.read([](const aisdi::Vector<int>& items) { return items.data()[0]; }), 11);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRcuVector_WhenAssigning_ThenContentsAreReplaced)
+{
+  aisdi::RcuVector<int> vector(aisdi::Vector<int>{ 1, 2, 3 });
+
+  vector.assign(aisdi::Vector<int>{ 4 });
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 1);
+  BOOST_CHECK_EQUAL(vector.read([](const aisdi::Vector<int>& items) { return items.data()[0]; }), 4);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFailingModification_WhenUpdating_ThenContentsAreUnchanged)
+{
+  aisdi::RcuVector<int> vector(aisdi::Vector<int>{ 1, 2, 3 });
+
+  BOOST_CHECK_THROW(vector.update([](aisdi::Vector<int>& items)
+  {
+    items.append(4);
+    throw std::runtime_error("failed");
+  }), std::runtime_error);
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 3);
+}
+
+// The writer keeps every element of a version equal, so a reader that ever
+// sees two different values has read a buffer while it was being rewritten.
+BOOST_AUTO_TEST_CASE(GivenReadersAndWriter_WhenUpdatingConcurrently_ThenReadersSeeWholeVersions)
+{
+  aisdi::Vector<int> initial;
+  for(int i = 0; i != 256; i++)
+    initial.append(0);
+  aisdi::RcuVector<int> vector(initial);
+  std::atomic<bool> writing(true);
+  std::atomic<bool> consistent(true);
+
+  std::vector<std::thread> readers;
+  for(int r = 0; r != 4; r++)
+    readers.emplace_back([&]()
+    {
+      int last = 0;
+      while(writing.load())
+      {
+        aisdi::RcuVector<int>::Snapshot snapshot(vector);
+        const int first = snapshot->data()[0];
+        for(std::size_t i = 1; i != snapshot->getSize(); i++)
+          if(snapshot->data()[i] != first)
+            consistent.store(false);
+        // versions only move forward
+        if(first < last)
+          consistent.store(false);
+        last = first;
+      }
+    });
+  for(int version = 1; version != 2000; version++)
+    vector.update([version](aisdi::Vector<int>& items)
+    {
+      for(std::size_t i = 0; i != items.getSize(); i++)
+        items.data()[i] = version;
+    });
+  writing.store(false);
+  for(auto& reader : readers)
+    reader.join();
+
+  BOOST_CHECK(consistent.load());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include <SoAVector.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using Records = aisdi::SoAVector<double, std::int32_t, std::string>;
+
+BOOST_AUTO_TEST_SUITE(SoAVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const Records collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK(collection.column<0>().isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenAppendingRows_ThenEveryColumnHoldsItsField)
+{
+  Records collection;
+
+  collection.append(1.5, 10, "a");
+  collection.append(2.5, 20, "b");
+  collection.append(3.5, 30, "c");
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  auto prices = collection.column<0>();
+  auto quantities = collection.column<1>();
+  BOOST_CHECK_EQUAL(prices.getSize(), 3);
+  BOOST_CHECK_EQUAL(std::accumulate(prices.begin(), prices.end(), 0.0), 7.5);
+  BOOST_CHECK_EQUAL(std::accumulate(quantities.begin(), quantities.end(), 0), 60);
+  BOOST_CHECK_EQUAL(collection.get<2>(1), "b");
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenGrowingPastCapacity_ThenColumnsStayContiguous)
+{
+  Records collection;
+
+  for(int i = 0; i != 1000; i++)
+    collection.append(i, i * 2, std::to_string(i));
+
+  auto quantities = collection.column<1>();
+  for(int i = 0; i != 1000; i++)
+    BOOST_REQUIRE_EQUAL(quantities.data()[i], i * 2);
+  BOOST_CHECK_EQUAL(collection.get<2>(999), "999");
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenPoppingLast_ThenLastRowIsReturned)
+{
+  Records collection;
+  collection.append(1.0, 1, "first");
+  collection.append(2.0, 2, "second");
+
+  auto row = collection.popLast();
+
+  BOOST_CHECK_EQUAL(std::get<1>(row), 2);
+  BOOST_CHECK_EQUAL(std::get<2>(row), "second");
+  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows)
+{
+  Records collection;
+
+  BOOST_CHECK_THROW(collection.popLast(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenErasingRow_ThenAllColumnsAreShifted)
+{
+  Records collection;
+  collection.append(1.0, 1, "a");
+  collection.append(2.0, 2, "b");
+  collection.append(3.0, 3, "c");
+
+  collection.erase(collection.begin() + 1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  BOOST_CHECK_EQUAL(collection.get<0>(1), 3.0);
+  BOOST_CHECK_EQUAL(collection.get<1>(1), 3);
+  BOOST_CHECK_EQUAL(collection.get<2>(1), "c");
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenErasingRange_ThenRowsAreRemoved)
+{
+  Records collection;
+  for(int i = 0; i != 5; i++)
+    collection.append(i, i, std::to_string(i));
+
+  collection.erase(collection.begin() + 1, collection.end() - 1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  BOOST_CHECK_EQUAL(collection.get<1>(0), 0);
+  BOOST_CHECK_EQUAL(collection.get<1>(1), 4);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenErasingEnd_ThenOperationThrows)
+{
+  Records collection;
+  collection.append(1.0, 1, "a");
+
+  BOOST_CHECK_THROW(collection.erase(collection.end()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIterator_WhenDereferencing_ThenRowCanBeChanged)
+{
+  Records collection;
+  collection.append(1.0, 1, "a");
+
+  std::get<1>(*collection.begin()) = 42;
+
+  BOOST_CHECK_EQUAL(collection.get<1>(0), 42);
+  BOOST_CHECK_EQUAL(std::get<2>(*collection.cbegin()), "a");
+  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCopying_ThenCopyIsIndependent)
+{
+  Records collection;
+  collection.append(1.0, 1, "a");
+
+  Records copy(collection);
+  copy.get<2>(0) = "changed";
+  Records moved(std::move(copy));
+
+  BOOST_CHECK_EQUAL(collection.get<2>(0), "a");
+  BOOST_CHECK_EQUAL(moved.get<2>(0), "changed");
+  BOOST_CHECK(copy.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
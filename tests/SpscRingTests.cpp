@@ -0,0 +1,141 @@
+#include <SpscRing.h>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(SpscRingTests)
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenCreated_ThenItIsEmptyWithPowerOfTwoCapacity)
+{
+  const aisdi::SpscRing<int> ring(100);
+
+  BOOST_CHECK(ring.isEmpty());
+  BOOST_CHECK_EQUAL(ring.getCapacity(), 128);
+}
+
+BOOST_AUTO_TEST_CASE(GivenZeroCapacity_WhenCreatingRing_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(aisdi::SpscRing<int> ring(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyRing_WhenPopping_ThenNothingIsReturned)
+{
+  aisdi::SpscRing<int> ring(4);
+  int item = 7;
+
+  BOOST_CHECK(!ring.tryPop(item));
+  BOOST_CHECK_EQUAL(item, 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenPushingAndPopping_ThenItemsComeOutInOrder)
+{
+  aisdi::SpscRing<std::string> ring(4);
+
+  BOOST_CHECK(ring.tryPush("a"));
+  BOOST_CHECK(ring.tryPush("b"));
+  BOOST_CHECK_EQUAL(ring.getSize(), 2);
+
+  std::string item;
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "a");
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK_EQUAL(item, "b");
+  BOOST_CHECK(ring.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullRing_WhenPushing_ThenItemIsRejected)
+{
+  aisdi::SpscRing<int> ring(4);
+  for(int i = 0; i != 4; i++)
+    BOOST_REQUIRE(ring.tryPush(i));
+
+  BOOST_CHECK(!ring.tryPush(4));
+
+  int item;
+  BOOST_CHECK(ring.tryPop(item));
+  BOOST_CHECK(ring.tryPush(4));
+}
+
+BOOST_AUTO_TEST_CASE(GivenAlmostFullRing_WhenPushingBatch_ThenOnlyWhatFitsIsTaken)
+{
+  aisdi::SpscRing<int> ring(8);
+  const int items[] = { 0, 1, 2, 3, 4, 5 };
+  ring.tryPushN(items, 5);
+
+  BOOST_CHECK_EQUAL(ring.tryPushN(items, 6), 3);
+  BOOST_CHECK_EQUAL(ring.getSize(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenPoppingBatchLargerThanSize_ThenAllItemsArePopped)
+{
+  aisdi::SpscRing<int> ring(8);
+  const int items[] = { 10, 11, 12 };
+  ring.tryPushN(items, 3);
+
+  int out[8];
+  BOOST_CHECK_EQUAL(ring.tryPopN(out, 8), 3);
+  BOOST_CHECK_EQUAL(out[0], 10);
+  BOOST_CHECK_EQUAL(out[2], 12);
+  BOOST_CHECK_EQUAL(ring.tryPopN(out, 8), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRing_WhenIndicesWrapAround_ThenOrderIsKept)
+{
+  aisdi::SpscRing<int> ring(4);
+  int next = 0;
+  int expected = 0;
+  for(int round = 0; round != 100; round++)
+  {
+    const int items[] = { next, next + 1, next + 2 };
+    next += (int)ring.tryPushN(items, 3);
+    int out[2];
+    const std::size_t popped = ring.tryPopN(out, 2);
+    for(std::size_t i = 0; i != popped; i++)
+      BOOST_REQUIRE_EQUAL(out[i], expected++);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenProducerAndConsumerThreads_WhenTransferring_ThenEveryItemArrivesInOrder)
+{
+  const int count = 200000;
+  aisdi::SpscRing<int> ring(64);
+
+  std::thread producer([&ring, count]()
+  {
+    int batch[16];
+    int next = 0;
+    while(next != count)
+    {
+      int size = 0;
+      while(size != 16 and next + size != count)
+      {
+        batch[size] = next + size;
+        size++;
+      }
+      next += (int)ring.tryPushN(batch, size);
+      if(next != count)
+        std::this_thread::yield();
+    }
+  });
+
+  int expected = 0;
+  bool inOrder = true;
+  while(expected != count)
+  {
+    int item;
+    if(ring.tryPop(item))
+      inOrder = inOrder and item == expected++;
+    else
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  BOOST_CHECK(inOrder);
+  BOOST_CHECK(ring.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+#include <Benchmark.h>
+#include <LinearBenchmarks.h>
+#include <StdAdapters.h>
+
+#include <cstddef>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using AdapterTypes = boost::mpl::list<aisdi::bench::StdVectorAdapter<int>,
+                                      aisdi::bench::StdDequeAdapter<int>,
+                                      aisdi::bench::StdListAdapter<int>>;
+
+namespace
+{
+
+template <typename Adapter>
+std::string contentsOf(const Adapter& items)
+{
+  std::string contents;
+  for(auto item = items.begin(); item != items.end(); ++item)
+    contents += std::to_string(*item);
+  return contents;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(StdAdaptersTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenAdapter_WhenUsedLikeAisdiContainer_ThenItBehavesTheSame,
+                              Adapter,
+                              AdapterTypes)
+{
+  Adapter items;
+  items.append(2);
+  items.append(3);
+  items.prepend(1);
+  items.append(5);
+  items.insert(items.cbegin() + 3, 4);
+
+  BOOST_CHECK_EQUAL(contentsOf(items), "12345");
+  BOOST_CHECK_EQUAL(items.popLast(), 5);
+
+  items.erase(items.cbegin() + 1, items.cbegin() + 3);
+
+  BOOST_CHECK_EQUAL(contentsOf(items), "14");
+  BOOST_CHECK_EQUAL(items.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenAdapter_WhenRunningLinearBenchmarks_ThenEveryOneCompletes,
+                              Adapter,
+                              AdapterTypes)
+{
+  aisdi::bench::Registry registry;
+  aisdi::bench::registerLinearBenchmarks<Adapter>(registry, "adapter", "int");
+  aisdi::bench::Options options;
+  options.sizes = { 100 };
+  options.repetitions = 1;
+  options.minSampleMicroseconds = 0;
+
+  const aisdi::Vector<aisdi::bench::Result> results = aisdi::bench::runSelected(registry, options);
+
+  BOOST_CHECK_EQUAL(results.getSize(), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
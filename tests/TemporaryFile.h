@@ -0,0 +1,26 @@
+#ifndef AISDI_LINEAR_TEMPORARYFILE_H
+#define AISDI_LINEAR_TEMPORARYFILE_H
+
+#include <cstdio>
+#include <string>
+
+// Removes the file written by a test even when a check throws. Suites that
+// need a default-constructible fixture derive one naming their file.
+struct TemporaryFile
+{
+  std::string path;
+
+  explicit TemporaryFile(const std::string& path_)
+    : path(path_)
+  {}
+
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+  ~TemporaryFile()
+  {
+    std::remove(path.c_str());
+  }
+};
+
+#endif // AISDI_LINEAR_TEMPORARYFILE_H
@@ -0,0 +1,70 @@
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <ThreadedBenchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+using ChurnedTypes = boost::mpl::list<aisdi::Vector<int>, aisdi::LinkedList<std::string>>;
+
+BOOST_AUTO_TEST_SUITE(ThreadedBenchmarkTests)
+
+BOOST_AUTO_TEST_CASE(GivenProcess_WhenPinningThreadToAllowedCpu_ThenItSucceeds)
+{
+  const aisdi::Vector<int> cpus = aisdi::bench::allowedCpus();
+  BOOST_REQUIRE(!cpus.isEmpty());
+
+  bool pinned = false;
+  std::thread thread([&]()
+  {
+    pinned = aisdi::bench::pinCurrentThread(*cpus.begin());
+  });
+  thread.join();
+
+  BOOST_CHECK(pinned);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPaddedSlots_WhenPlaced_ThenEveryOneStartsItsOwnCacheLine)
+{
+  using Slot = aisdi::detail::CacheLinePadded<aisdi::LinkedList<int>>;
+  aisdi::bench::detail::SlotArray<Slot> slots(3);
+
+  for(std::size_t index = 0; index != 3; index++)
+  {
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&slots[index].value);
+    BOOST_CHECK_EQUAL(address % aisdi::detail::cacheLineSize, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEveryMode_WhenRunningThreads_ThenAllFinishPinned,
+                              Container,
+                              ChurnedTypes)
+{
+  const aisdi::Vector<int> cpus = aisdi::bench::allowedCpus();
+
+  for(std::size_t mode = 0; mode != aisdi::bench::threadingModeCount; mode++)
+  {
+    const aisdi::bench::ThreadedRun run =
+      aisdi::bench::runThreaded<Container>((aisdi::bench::ThreadingMode)mode, 3, 100, 2, cpus);
+
+    BOOST_CHECK(run.nanoseconds > 0);
+    BOOST_CHECK(run.pinned);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoCpus_WhenRunningThreads_ThenNothingIsReportedUnpinned)
+{
+  const aisdi::bench::ThreadedRun run = aisdi::bench::runThreaded<aisdi::LinkedList<int>>(
+    aisdi::bench::sharedContainer, 2, 10, 1, aisdi::Vector<int>());
+
+  BOOST_CHECK(run.pinned);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+#include <LinkedList.h>
+#include <Vector.h>
+
+#include <StdAdapters.h>
+#include <Trace.h>
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+#include "TemporaryFile.h"
+
+using TracedTypes = boost::mpl::list<aisdi::Vector<int>, aisdi::LinkedList<int>>;
+
+using ReplayedTypes = boost::mpl::list<aisdi::Vector<int>, aisdi::LinkedList<int>,
+                                       aisdi::bench::StdVectorAdapter<int>,
+                                       aisdi::bench::StdDequeAdapter<int>,
+                                       aisdi::bench::StdListAdapter<int>>;
+
+namespace
+{
+
+struct TraceFile : TemporaryFile
+{
+  TraceFile()
+    : TemporaryFile("aisdi_trace_test.trace")
+  {}
+};
+
+template <typename Container>
+std::string contentsOf(const Container& items)
+{
+  std::string contents;
+  for(auto item = items.begin(); item != items.end(); ++item)
+    contents += std::to_string(*item) + " ";
+  return contents;
+}
+
+// Touches every operation, at both ends and in the middle.
+template <typename Container>
+void recordWorkload(aisdi::bench::TracingContainer<Container>& items)
+{
+  for(int value = 0; value != 10; value++)
+    items.append(value);
+  items.prepend(-1);
+  items.insert(items.cbegin() + 4, 40);
+  items.erase(items.cbegin() + 7);
+  items.erase(items.cbegin() + 2, items.cbegin() + 5);
+  items.popFirst();
+  items.popLast();
+  items.scan([](int) {});
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(TraceTests, TraceFile)
+
+BOOST_AUTO_TEST_CASE(GivenWrittenRecords_WhenReading_ThenTheSameComeBack)
+{
+  const std::uint64_t big = ~std::uint64_t(0);
+  {
+    aisdi::bench::TraceWriter trace(path);
+    trace.write(aisdi::bench::traceAppend, 0, 5);
+    trace.write(aisdi::bench::traceInsert, 300, big);
+    trace.write(aisdi::bench::tracePopLast);
+    trace.close();
+    BOOST_CHECK_EQUAL(trace.getCount(), 3);
+  }
+
+  aisdi::bench::TraceReader trace(path);
+  aisdi::bench::TraceRecord record;
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::traceAppend);
+  BOOST_CHECK_EQUAL(record.value, 5);
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::traceInsert);
+  BOOST_CHECK_EQUAL(record.position, 300);
+  BOOST_CHECK_EQUAL(record.value, big);
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::tracePopLast);
+  BOOST_CHECK(!trace.next(record));
+}
+
+BOOST_AUTO_TEST_CASE(GivenTraceLongerThanBuffer_WhenReading_ThenEveryRecordIsStreamed)
+{
+  const std::uint64_t count = 100000;
+  {
+    aisdi::bench::TraceWriter trace(path);
+    for(std::uint64_t value = 0; value != count; value++)
+      trace.write(aisdi::bench::traceInsert, value, value * 1000);
+    trace.close();
+  }
+
+  aisdi::bench::TraceReader trace(path);
+  aisdi::bench::TraceRecord record;
+  std::uint64_t read = 0;
+  bool same = true;
+  while(trace.next(record))
+  {
+    same = same and record.position == read and record.value == read * 1000;
+    read++;
+  }
+  BOOST_CHECK_EQUAL(read, count);
+  BOOST_CHECK(same);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOtherOrTruncatedFile_WhenReading_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(aisdi::bench::TraceReader(path + ".missing"), std::runtime_error);
+
+  std::ofstream(path.c_str())<<"not a trace at all";
+  BOOST_CHECK_THROW(aisdi::bench::TraceReader trace(path), std::runtime_error);
+
+  {
+    aisdi::bench::TraceWriter trace(path);
+    trace.write(aisdi::bench::traceAppend, 0, 1000);
+    trace.close();
+  }
+  std::string bytes;
+  {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  std::ofstream(path.c_str(), std::ios::binary | std::ios::trunc)<<bytes.substr(0, bytes.size() - 1);
+  aisdi::bench::TraceReader trace(path);
+  aisdi::bench::TraceRecord record;
+  BOOST_CHECK_THROW(trace.next(record), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTracingContainer_WhenModified_ThenPositionsAreLogged,
+                              Container,
+                              TracedTypes)
+{
+  {
+    aisdi::bench::TraceWriter trace(path);
+    aisdi::bench::TracingContainer<Container> items(trace);
+    recordWorkload(items);
+    trace.close();
+    BOOST_CHECK_EQUAL(trace.getCount(), 17);
+  }
+
+  aisdi::bench::TraceReader trace(path);
+  aisdi::bench::TraceRecord record;
+  for(int skipped = 0; skipped != 11; skipped++)
+    trace.next(record);
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::traceInsert);
+  BOOST_CHECK_EQUAL(record.position, 4);
+  BOOST_CHECK_EQUAL(record.value, 40);
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::traceErase);
+  BOOST_CHECK_EQUAL(record.position, 7);
+  BOOST_REQUIRE(trace.next(record));
+  BOOST_CHECK_EQUAL(record.operation, aisdi::bench::traceEraseRange);
+  BOOST_CHECK_EQUAL(record.position, 2);
+  BOOST_CHECK_EQUAL(record.value, 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenRecordedTrace_WhenReplayed_ThenContainerEndsTheSame,
+                              Container,
+                              ReplayedTypes)
+{
+  aisdi::bench::TraceWriter writer(path);
+  aisdi::bench::TracingContainer<aisdi::Vector<int>> recorded(writer);
+  recordWorkload(recorded);
+  writer.close();
+
+  aisdi::bench::TraceReader trace(path);
+  Container replayed;
+  const aisdi::bench::ReplayResult result = aisdi::bench::replayTrace(trace, replayed);
+
+  BOOST_CHECK_EQUAL(contentsOf(replayed), contentsOf(recorded));
+  BOOST_CHECK_EQUAL(result.operations, 17);
+  BOOST_CHECK_EQUAL(result.counts[aisdi::bench::traceAppend], 10);
+  BOOST_CHECK_EQUAL(result.getLatencies(aisdi::bench::traceScan).getCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTraceNotFittingContainer_WhenReplayed_ThenExceptionIsThrown)
+{
+  {
+    aisdi::bench::TraceWriter trace(path);
+    trace.write(aisdi::bench::traceAppend, 0, 1);
+    trace.write(aisdi::bench::traceErase, 1);
+    trace.close();
+  }
+
+  aisdi::bench::TraceReader trace(path);
+  aisdi::LinkedList<int> items;
+  BOOST_CHECK_THROW(aisdi::bench::replayTrace(trace, items), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -932,6 +932,117 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIf_ThenMatchingItemsAreRemovedInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 2, 5, 2 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(2); });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  thenCollectionContainsValues(collection, { 1, 3, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIfNothingMatches_ThenCollectionIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.removeIf([](const T& item) { return item == T(42); });
+
+  BOOST_CHECK_EQUAL(removed, 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingIfEverythingMatches_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  collection.removeIf([](const T&) { return true; });
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapErasing_ThenLastItemFillsTheHole,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+
+  collection.swapErase(begin(collection) + 1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  thenCollectionContainsValues(collection, { 1, 4, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapErasingLastItem_ThenItIsRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2 };
+
+  collection.swapErase(end(collection) - 1);
+
+  thenCollectionContainsValues(collection, { 1 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSwapErasingEnd_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> empty;
+  LinearCollection<T> collection = { 1 };
+
+  BOOST_CHECK_THROW(empty.swapErase(empty.end()), std::out_of_range);
+  BOOST_CHECK_THROW(collection.swapErase(collection.end()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenReserving_ThenItemsAreKeptAndCapacityGrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  collection.reserve(100);
+
+  BOOST_CHECK_GE(collection.getCapacity(), 100);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  BOOST_CHECK(collection.data()[2] == T(3));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReservingLess_ThenCapacityIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  auto capacity = collection.getCapacity();
+
+  collection.reserve(1);
+
+  BOOST_CHECK_EQUAL(collection.getCapacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithEnoughCapacity_WhenCopyAssigning_ThenStorageIsReused,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  collection.reserve(100);
+  const auto storage = collection.data();
+  const LinearCollection<T> other = { 1, 2, 3 };
+
+  collection = other;
+
+  BOOST_CHECK(collection.data() == storage);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 